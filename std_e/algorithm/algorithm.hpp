@@ -2,6 +2,8 @@
 
 
 #include <algorithm>
+#include <cstddef>
+#include <type_traits>
 
 
 namespace std_e {
@@ -46,6 +48,29 @@ lower_bound_position(const Random_access_range& r, const T& value) {
   return it-begin(r);
 }
 
+/**
+  Same as lower_bound_position, for a contiguous sorted range [first,first+n) of arithmetic values
+  The binary search is branchless: the range is halved with a conditional move instead of a branch,
+  so that there are no mispredictions (they are 50% with a random `value`)
+  The last `linear_search_size` elements are compared with a counting loop, that the compiler vectorizes
+*/
+template<class T> constexpr auto
+branchless_lower_bound_position(const T* first, std::ptrdiff_t n, const T& value) -> std::ptrdiff_t {
+  static_assert(std::is_arithmetic_v<T>);
+  constexpr std::ptrdiff_t linear_search_size = 64/sizeof(T); // one cache line
+  const T* base = first;
+  while (n>linear_search_size) {
+    std::ptrdiff_t half = n/2;
+    base = (base[half-1]<value) ? base+half : base;
+    n -= half;
+  }
+  std::ptrdiff_t n_less = 0;
+  for (std::ptrdiff_t i=0; i<n; ++i) {
+    n_less += (base[i]<value);
+  }
+  return (base-first) + n_less;
+}
+
 
 template<class Range, class I> auto
 // requires I is an arithmetic type
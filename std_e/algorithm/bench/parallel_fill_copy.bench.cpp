@@ -0,0 +1,61 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/algorithm/parallel_fill_copy.hpp"
+#include <numeric>
+#include <vector>
+
+using namespace std_e;
+
+
+namespace {
+
+
+STD_E_BENCHMARK("fill/std", 1<<16, 1<<20, 1<<24) {
+  std::vector<double> v(state.size());
+  state.set_items_processed(v.size());
+
+  state.run([&](){ std::fill(begin(v),end(v),1.5); do_not_optimize(v); });
+}
+
+STD_E_BENCHMARK("fill/seq", 1<<16, 1<<20, 1<<24) {
+  std::vector<double> v(state.size());
+  state.set_items_processed(v.size());
+
+  state.run([&](){ std_e::fill(seq,v.data(),v.data()+v.size(),1.5); do_not_optimize(v); });
+}
+
+STD_E_BENCHMARK("fill/par", 1<<16, 1<<20, 1<<24) {
+  std::vector<double> v(state.size());
+  state.set_items_processed(v.size());
+
+  state.run([&](){ std_e::fill(par,v.data(),v.data()+v.size(),1.5); do_not_optimize(v); });
+}
+
+STD_E_BENCHMARK("copy/std", 1<<16, 1<<20, 1<<24) {
+  std::vector<double> v(state.size());
+  std::iota(begin(v),end(v),0.);
+  std::vector<double> w(state.size());
+  state.set_items_processed(v.size());
+
+  state.run([&](){ std::copy(begin(v),end(v),begin(w)); do_not_optimize(w); });
+}
+
+STD_E_BENCHMARK("copy/seq", 1<<16, 1<<20, 1<<24) {
+  std::vector<double> v(state.size());
+  std::iota(begin(v),end(v),0.);
+  std::vector<double> w(state.size());
+  state.set_items_processed(v.size());
+
+  state.run([&](){ std_e::copy(seq,v.data(),v.data()+v.size(),w.data()); do_not_optimize(w); });
+}
+
+STD_E_BENCHMARK("copy/par", 1<<16, 1<<20, 1<<24) {
+  std::vector<double> v(state.size());
+  std::iota(begin(v),end(v),0.);
+  std::vector<double> w(state.size());
+  state.set_items_processed(v.size());
+
+  state.run([&](){ std_e::copy(par,v.data(),v.data()+v.size(),w.data()); do_not_optimize(w); });
+}
+
+
+} // anonymous
@@ -0,0 +1,140 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/algorithm/partition_sort.hpp"
+#include <random>
+
+using namespace std_e;
+
+
+namespace {
+
+
+auto
+random_values(std::int64_t n, int max_value) -> std::vector<int> {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0,max_value-1);
+  std::vector<int> v(n);
+  for (auto& x : v) {
+    x = dist(gen);
+  }
+  return v;
+}
+auto
+regular_pivots(int k, int max_value) -> std::vector<int> {
+  std::vector<int> pivots(k);
+  for (int i=0; i<k; ++i) {
+    pivots[i] = (long long)(i+1)*max_value/(k+1);
+  }
+  return pivots;
+}
+
+constexpr int max_value = 1'000'000'000;
+
+template<int k> auto
+bench_partition_sort_indices(benchmark_state& state) -> void {
+  auto v0 = random_values(state.size(),max_value);
+  auto pivots = regular_pivots(k,max_value);
+  std::vector<int> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){
+      auto partition_indices = partition_sort_indices(v,pivots);
+      do_not_optimize(partition_indices);
+    }
+  );
+}
+
+
+template<int k> auto
+bench_bucket_partition_sort_indices(benchmark_state& state) -> void {
+  auto v0 = random_values(state.size(),max_value);
+  auto pivots = regular_pivots(k,max_value);
+  std::vector<int> v;
+  std::vector<int> partition_indices(k);
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){
+      bucket_partition_sort_indices(begin(v),end(v),begin(pivots),end(pivots),begin(partition_indices));
+      do_not_optimize(partition_indices);
+    }
+  );
+}
+
+template<int k> auto
+bench_parallel_partition_sort_indices(benchmark_state& state) -> void {
+  auto v0 = random_values(state.size(),max_value);
+  auto pivots = regular_pivots(k,max_value);
+  std::vector<int> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){
+      auto partition_indices = partition_sort_indices(par,v,pivots);
+      do_not_optimize(partition_indices);
+    }
+  );
+}
+
+
+STD_E_BENCHMARK("partition_sort_indices/k=16", 1<<10, 1<<16, 1<<20, 1<<23) {
+  bench_partition_sort_indices<16>(state);
+}
+STD_E_BENCHMARK("partition_sort_indices/k=1024", 1<<10, 1<<16, 1<<20, 1<<23) {
+  bench_partition_sort_indices<1024>(state);
+}
+
+STD_E_BENCHMARK("partition_sort_indices/bucket/k=16", 1<<10, 1<<16, 1<<20, 1<<23) {
+  bench_bucket_partition_sort_indices<16>(state);
+}
+STD_E_BENCHMARK("partition_sort_indices/bucket/k=1024", 1<<10, 1<<16, 1<<20, 1<<23) {
+  bench_bucket_partition_sort_indices<1024>(state);
+}
+STD_E_BENCHMARK("partition_sort_indices/par/k=16", 1<<10, 1<<16, 1<<20, 1<<23) {
+  bench_parallel_partition_sort_indices<16>(state);
+}
+STD_E_BENCHMARK("partition_sort_indices/par/k=1024", 1<<10, 1<<16, 1<<20, 1<<23) {
+  bench_parallel_partition_sort_indices<1024>(state);
+}
+
+STD_E_BENCHMARK("sort_into_partitions/16_values", 1<<10, 1<<16, 1<<20) {
+  auto v0 = random_values(state.size(),16);
+  std::vector<int> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){
+      auto jv = sort_into_partitions(std::move(v),[](int x){ return x; });
+      do_not_optimize(jv);
+    }
+  );
+}
+
+STD_E_BENCHMARK("sort_into_partitions/par/16_values", 1<<10, 1<<16, 1<<20) {
+  auto v0 = random_values(state.size(),16);
+  std::vector<int> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){
+      auto jv = sort_into_partitions(par,std::move(v),[](int x){ return x; });
+      do_not_optimize(jv);
+    }
+  );
+}
+
+STD_E_BENCHMARK("sort_into_partitions/spread_values", 1<<10, 1<<16, 1<<20) {
+  auto v0 = random_values(state.size(),max_value);
+  std::vector<int> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){
+      auto jv = sort_into_partitions(std::move(v),[](int x){ return x%(1<<20); });
+      do_not_optimize(jv);
+    }
+  );
+}
+
+
+} // anonymous
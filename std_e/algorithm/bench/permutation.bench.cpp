@@ -0,0 +1,149 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/algorithm/permutation.hpp"
+#include <random>
+
+using namespace std_e;
+
+
+namespace {
+
+
+auto
+random_permutation(std::int64_t n) -> std::vector<int> {
+  std::vector<int> p(n);
+  std::iota(begin(p),end(p),0);
+  std::shuffle(begin(p),end(p),std::mt19937(42));
+  return p;
+}
+auto
+random_values(std::int64_t n) -> std::vector<int> {
+  std::mt19937 gen(43);
+  std::uniform_int_distribution<int> dist(0,1'000'000'000);
+  std::vector<int> v(n);
+  for (auto& x : v) {
+    x = dist(gen);
+  }
+  return v;
+}
+
+
+STD_E_BENCHMARK("permutation/permute", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto p = random_permutation(state.size());
+  std::vector<double> v0(p.size(),1.);
+  std::vector<double> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){ permute(v,p); do_not_optimize(v); }
+  );
+}
+
+STD_E_BENCHMARK("permutation/permute_4_ranges/separately", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto p = random_permutation(state.size());
+  std::vector<double> v0(p.size(),1.);
+  std::vector<double> v1,v2,v3,v4;
+
+  state.run(
+    [&](){ v1 = v0; v2 = v0; v3 = v0; v4 = v0; },
+    [&](){
+      permute(v1,p); permute(v2,p); permute(v3,p); permute(v4,p);
+      do_not_optimize(v4);
+    }
+  );
+}
+
+STD_E_BENCHMARK("permutation/permute_4_ranges/plan", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto p = random_permutation(state.size());
+  std::vector<double> v0(p.size(),1.);
+  std::vector<double> v1,v2,v3,v4;
+
+  state.run(
+    [&](){ v1 = v0; v2 = v0; v3 = v0; v4 = v0; },
+    [&](){
+      permutation_plan plan(p);
+      plan.apply(v1,v2,v3,v4);
+      do_not_optimize(v4);
+    }
+  );
+}
+
+// direct vs blocked: the blocked gather is expected to win above the last level cache size
+STD_E_BENCHMARK("permutation/permute_copy", 1<<10, 1<<16, 1<<20, 1<<23, 1<<25, 1<<26) {
+  auto p = random_permutation(state.size());
+  std::vector<double> v(p.size(),1.);
+  std::vector<double> w;
+
+  state.run([&](){
+    w = permute_copy(v,p);
+    do_not_optimize(w);
+  });
+}
+
+STD_E_BENCHMARK("permutation/permute_copy/blocked", 1<<10, 1<<16, 1<<20, 1<<23, 1<<25, 1<<26) {
+  auto p = random_permutation(state.size());
+  std::vector<double> v(p.size(),1.);
+  std::vector<double> w;
+
+  state.run([&](){
+    w = permute_copy(blocked_gather,v,p);
+    do_not_optimize(w);
+  });
+}
+
+STD_E_BENCHMARK("permutation/compose_permutations", 1<<16, 1<<20, 1<<23, 1<<25, 1<<26) {
+  auto p0 = random_permutation(state.size());
+  auto p1 = p0;
+  std::reverse(begin(p1),end(p1));
+  std::vector<int> p;
+
+  state.run([&](){
+    p = compose_permutations(p0,p1);
+    do_not_optimize(p);
+  });
+}
+
+STD_E_BENCHMARK("permutation/compose_permutations/blocked", 1<<16, 1<<20, 1<<23, 1<<25, 1<<26) {
+  auto p0 = random_permutation(state.size());
+  auto p1 = p0;
+  std::reverse(begin(p1),end(p1));
+  std::vector<int> p;
+
+  state.run([&](){
+    p = compose_permutations(blocked_gather,p0,p1);
+    do_not_optimize(p);
+  });
+}
+
+STD_E_BENCHMARK("permutation/sort_permutation", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto v = random_values(state.size());
+  std::vector<int> p;
+
+  state.run([&](){
+    p = sort_permutation(v);
+    do_not_optimize(p);
+  });
+}
+
+STD_E_BENCHMARK("permutation/sort_permutation/indirect", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto v = random_values(state.size());
+  std::vector<int> p;
+
+  state.run([&](){
+    // a custom sort_algo forces the indirect engine
+    p = sort_permutation(v,std::less<>{},[](auto f, auto l, auto comp){ std::sort(f,l,comp); });
+    do_not_optimize(p);
+  });
+}
+
+STD_E_BENCHMARK("permutation/sort_permutation/par", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto v = random_values(state.size());
+  std::vector<int> p;
+
+  state.run([&](){
+    p = sort_permutation(par,v);
+    do_not_optimize(p);
+  });
+}
+
+
+} // anonymous
@@ -0,0 +1,54 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/algorithm/radix_sort.hpp"
+#include <random>
+
+using namespace std_e;
+
+
+namespace {
+
+
+template<class T> auto
+random_values(std::int64_t n) -> std::vector<T> {
+  std::mt19937_64 gen(44);
+  std::uniform_int_distribution<std::int64_t> dist(-1'000'000'000,1'000'000'000);
+  std::vector<T> v(n);
+  for (auto& x : v) {
+    x = T(dist(gen));
+  }
+  return v;
+}
+
+
+STD_E_BENCHMARK("radix_sort/int32", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto v0 = random_values<std::int32_t>(state.size());
+  std::vector<std::int32_t> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){ radix_sort(begin(v),end(v)); do_not_optimize(v); }
+  );
+}
+
+STD_E_BENCHMARK("radix_sort/int32/std_sort", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto v0 = random_values<std::int32_t>(state.size());
+  std::vector<std::int32_t> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){ std::sort(begin(v),end(v)); do_not_optimize(v); }
+  );
+}
+
+STD_E_BENCHMARK("radix_sort/double", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto v0 = random_values<double>(state.size());
+  std::vector<double> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){ radix_sort(begin(v),end(v)); do_not_optimize(v); }
+  );
+}
+
+
+} // anonymous
@@ -0,0 +1,43 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/algorithm/parallel_scan.hpp"
+#include <numeric>
+
+using namespace std_e;
+
+
+namespace {
+
+
+auto
+strides(std::int64_t n) -> std::vector<int> {
+  std::vector<int> v(n);
+  for (std::int64_t i=0; i<n; ++i) {
+    v[i] = i%7;
+  }
+  return v;
+}
+
+
+STD_E_BENCHMARK("inclusive_scan/std", 1<<10, 1<<16, 1<<20, 1<<24) {
+  auto v = strides(state.size());
+  std::vector<int> res(v.size());
+
+  state.run([&](){ std::inclusive_scan(begin(v),end(v),begin(res)); do_not_optimize(res); });
+}
+
+STD_E_BENCHMARK("inclusive_scan", 1<<10, 1<<16, 1<<20, 1<<24) {
+  auto v = strides(state.size());
+  std::vector<int> res(v.size());
+
+  state.run([&](){ std_e::inclusive_scan(begin(v),end(v),begin(res)); do_not_optimize(res); });
+}
+
+STD_E_BENCHMARK("inclusive_scan/par", 1<<10, 1<<16, 1<<20, 1<<24) {
+  auto v = strides(state.size());
+  std::vector<int> res(v.size());
+
+  state.run([&](){ std_e::inclusive_scan(par,begin(v),end(v),begin(res)); do_not_optimize(res); });
+}
+
+
+} // anonymous
@@ -0,0 +1,73 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/algorithm/sorting_networks.hpp"
+#include <random>
+
+using namespace std_e;
+
+
+namespace {
+
+
+// `n` small arrays of size `sz`, stored contiguously (e.g. the vertices of `n` elements)
+auto
+random_small_arrays(std::int64_t n, int sz) -> std::vector<int> {
+  std::mt19937 gen(45);
+  std::uniform_int_distribution<int> dist(0,1'000'000);
+  std::vector<int> v(n*sz);
+  for (auto& x : v) {
+    x = dist(gen);
+  }
+  return v;
+}
+
+template<class Sort> auto
+bench_small_sorts(benchmark_state& state, int sz, Sort sort) -> void {
+  auto v0 = random_small_arrays(state.size(),sz);
+  std::vector<int> v;
+  state.run(
+    [&](){ v = v0; },
+    [&](){
+      for (std::int64_t i=0; i<state.size(); ++i) {
+        sort(v.data()+i*sz,v.data()+(i+1)*sz);
+      }
+      do_not_optimize(v);
+    }
+  );
+}
+
+auto sort_small_f = [](int* f, int* l){ sort_small(f,l); };
+auto std_sort_f   = [](int* f, int* l){ std::sort(f,l); };
+
+
+STD_E_BENCHMARK("sorting_networks/sort_small/size=8", 1<<16) {
+  bench_small_sorts(state,8,sort_small_f);
+}
+STD_E_BENCHMARK("sorting_networks/std_sort/size=8", 1<<16) {
+  bench_small_sorts(state,8,std_sort_f);
+}
+STD_E_BENCHMARK("sorting_networks/sort_small/size=27", 1<<16) {
+  bench_small_sorts(state,27,sort_small_f);
+}
+STD_E_BENCHMARK("sorting_networks/std_sort/size=27", 1<<16) {
+  bench_small_sorts(state,27,std_sort_f);
+}
+
+STD_E_BENCHMARK("sorting_networks/sort_rows/size=8", 1<<16) {
+  auto v0 = random_small_arrays(state.size(),8);
+  std::vector<int> v;
+  state.run(
+    [&](){ v = v0; },
+    [&](){ sort_rows<8>(make_strided_span<8>(v)); do_not_optimize(v); }
+  );
+}
+STD_E_BENCHMARK("sorting_networks/sort_rows/size=27", 1<<16) {
+  auto v0 = random_small_arrays(state.size(),27);
+  std::vector<int> v;
+  state.run(
+    [&](){ v = v0; },
+    [&](){ sort_rows<27>(make_strided_span<27>(v)); do_not_optimize(v); }
+  );
+}
+
+
+} // anonymous
@@ -0,0 +1,66 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/utils/vector.hpp"
+#include <random>
+
+using namespace std_e;
+
+
+namespace {
+
+
+auto
+random_values_with_duplicates(std::int64_t n) -> std::vector<int> {
+  std::mt19937_64 gen(45);
+  std::uniform_int_distribution<int> dist(0,n/4); // ~4 occurrences of each value
+  std::vector<int> v(n);
+  for (auto& x : v) {
+    x = dist(gen);
+  }
+  return v;
+}
+
+
+STD_E_BENCHMARK("sort_unique", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto v0 = random_values_with_duplicates(state.size());
+  std::vector<int> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){ sort_unique(v); do_not_optimize(v); }
+  );
+}
+
+STD_E_BENCHMARK("sort_unique/par", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto v0 = random_values_with_duplicates(state.size());
+  std::vector<int> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){ sort_unique(par,v); do_not_optimize(v); }
+  );
+}
+
+STD_E_BENCHMARK("unique", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto v0 = random_values_with_duplicates(state.size());
+  std::sort(begin(v0),end(v0));
+  std::vector<int> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){ unique(v); do_not_optimize(v); }
+  );
+}
+
+STD_E_BENCHMARK("unique/par", 1<<10, 1<<16, 1<<20, 1<<23) {
+  auto v0 = random_values_with_duplicates(state.size());
+  std::sort(begin(v0),end(v0));
+  std::vector<int> v;
+
+  state.run(
+    [&](){ v = v0; },
+    [&](){ unique(par,v); do_not_optimize(v); }
+  );
+}
+
+
+} // anonymous
@@ -2,7 +2,7 @@
 
 
 #include <algorithm>
-#include "std_e/multi_index/multi_index_range.hpp"
+#include "std_e/multi_index/for_each_multi_index.hpp"
 
 
 namespace std_e {
@@ -37,13 +37,12 @@ concatenate_on_axis(int axis, const Multi_arrays& in_arrays, Multi_array& out_ar
   //      - of the extent of in_arrays for all other axes
   int offset = 0;
   for (auto& in_array : in_arrays) {
-    auto gen = fortran_multi_index_range(in_array.extent());
-    for (const auto& indices : gen) {
+    for_each_multi_index(in_array.extent(),[&](const auto& indices){
       auto cat_indices = indices;
       cat_indices[axis] += offset;
 
       out_array(cat_indices) = in_array(indices);
-    }
+    });
     offset += in_array.extent(axis);
   }
 }
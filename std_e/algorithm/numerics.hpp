@@ -1,6 +1,10 @@
 #pragma once
 
 
+#include <functional>
+#include "std_e/algorithm/simd_scan.hpp"
+
+
 namespace std_e {
 
 
@@ -10,6 +14,15 @@ partial_accumulate(InputIt first, InputIt last, OutputIt d_first, const T& init)
   // Precondition: 
   //  [first,last) valid range
   //  [d_first,d_first+n+1) valid range where n = last-first
+  if constexpr (use_simd_scan<InputIt,OutputIt,T,std::plus<>>) {
+    if (!detail::is_constant_evaluated()) {
+      *d_first = init;
+      ++d_first;
+      simd_scan<true>(first,last,d_first,init);
+      return d_first + (last-first);
+    }
+  }
+
   T acc = init;
   *d_first = acc;
 
@@ -27,6 +40,15 @@ partial_accumulate(InputIt first, InputIt last, OutputIt d_first, const T& init,
   // Precondition: 
   //  [first,last) valid range
   //  [d_first,d_first+n+1) valid range where n = last-first
+  if constexpr (use_simd_scan<InputIt,OutputIt,T,BinaryOperation>) {
+    if (!detail::is_constant_evaluated()) {
+      *d_first = init;
+      ++d_first;
+      simd_scan<true>(first,last,d_first,init);
+      return d_first + (last-first);
+    }
+  }
+
   T acc = init;
   *d_first = acc;
 
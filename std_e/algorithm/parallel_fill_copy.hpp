@@ -0,0 +1,260 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include "std_e/execution/execution.hpp"
+#include "std_e/future/is_detected.hpp"
+#include "std_e/future/contract.hpp"
+#include "std_e/multi_array/shape/layout.hpp"
+#if defined(__SSE2__)
+  #include <immintrin.h>
+#endif
+
+
+namespace std_e {
+
+
+/**
+  fill(pol,first,last,value) and copy(pol,first,last,d_first), for large ranges
+    - with a parallel_policy, the range is split in `n_chunk(pol,n)` chunks of equal size (see for_each_chunk),
+      each one written by its own thread
+    - if the range is contiguous, of trivially copyable elements, and bigger than `non_temporal_threshold` bytes,
+      the writes are non-temporal (streaming stores): they go directly to memory instead of evicting the cache
+      (the range would not fit in the cache anyway)
+
+  NUMA first touch:
+    The memory pages are placed on the NUMA node of the thread that writes them first.
+    If the memory has not been touched before (e.g. the elements of an uninitialized_multi_array, see multi_array_types.hpp),
+    then filling it with `fill(pol,...)` places each chunk on the node of the thread that will later work on it,
+    provided that the computation is also split with `pol` over the same range (e.g. by for_each_chunk(pol,n,f))
+*/
+inline constexpr std::size_t non_temporal_threshold = std::size_t(1)<<24; // bytes, about the size of a last level cache
+
+
+namespace detail {
+  template<class It> constexpr bool is_pointer_to_trivially_copyable =
+    std::is_pointer_v<It> && std::is_trivially_copyable_v<std::remove_pointer_t<It>>;
+
+  template<class T> auto
+  use_non_temporal(std::ptrdiff_t n) -> bool {
+    return std::size_t(n)*sizeof(T) >= non_temporal_threshold;
+  }
+
+  #if defined(__SSE2__)
+    constexpr std::size_t stream_bytes = 16;
+
+    template<class T> auto
+    stream_fill(T* first, std::ptrdiff_t n, const T& value) -> void {
+      if constexpr (stream_bytes%sizeof(T)==0) {
+        if (reinterpret_cast<std::uintptr_t>(first)%sizeof(T)==0) {
+          // scalar head, until `first` is aligned on `stream_bytes`
+          std::ptrdiff_t n_head = ((stream_bytes - reinterpret_cast<std::uintptr_t>(first)%stream_bytes)%stream_bytes)/sizeof(T);
+          n_head = std::min(n_head,n);
+          std::fill_n(first,n_head,value);
+          first += n_head;
+          n -= n_head;
+
+          // streaming stores of `value` repeated
+          constexpr int n_per_store = stream_bytes/sizeof(T);
+          T pattern[n_per_store];
+          std::fill_n(pattern,n_per_store,value);
+          __m128i v;
+          std::memcpy(&v,pattern,stream_bytes);
+          std::ptrdiff_t n_store = n/n_per_store;
+          for (std::ptrdiff_t i=0; i<n_store; ++i) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(first)+i,v);
+          }
+          _mm_sfence();
+
+          // scalar tail
+          std::fill_n(first+n_store*n_per_store,n-n_store*n_per_store,value);
+          return;
+        }
+      }
+      std::fill_n(first,n,value);
+    }
+
+    template<class T> auto
+    stream_copy(const T* first, std::ptrdiff_t n, T* d_first) -> void {
+      auto* src = reinterpret_cast<const std::byte*>(first);
+      auto* dst = reinterpret_cast<std::byte*>(d_first);
+      std::size_t n_bytes = n*sizeof(T);
+
+      // byte head, until `dst` is aligned on `stream_bytes`
+      std::size_t n_head = std::min((stream_bytes - reinterpret_cast<std::uintptr_t>(dst)%stream_bytes)%stream_bytes,n_bytes);
+      std::memcpy(dst,src,n_head);
+      src += n_head;
+      dst += n_head;
+      n_bytes -= n_head;
+
+      std::size_t n_store = n_bytes/stream_bytes;
+      for (std::size_t i=0; i<n_store; ++i) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)+i);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst)+i,v);
+      }
+      _mm_sfence();
+
+      std::memcpy(dst+n_store*stream_bytes,src+n_store*stream_bytes,n_bytes-n_store*stream_bytes);
+    }
+  #else
+    template<class T> auto
+    stream_fill(T* first, std::ptrdiff_t n, const T& value) -> void {
+      std::fill_n(first,n,value);
+    }
+    template<class T> auto
+    stream_copy(const T* first, std::ptrdiff_t n, T* d_first) -> void {
+      std::copy_n(first,n,d_first);
+    }
+  #endif
+
+  template<class Rand_it, class T> auto
+  fill_chunk(Rand_it first, std::ptrdiff_t n, const T& value, bool non_temporal) -> void {
+    if constexpr (is_pointer_to_trivially_copyable<Rand_it>) {
+      using value_type = std::remove_pointer_t<Rand_it>;
+      if (non_temporal) return stream_fill(first,n,value_type(value));
+    }
+    std::fill_n(first,n,value);
+  }
+  template<class Rand_it0, class Rand_it1> auto
+  copy_chunk(Rand_it0 first, std::ptrdiff_t n, Rand_it1 d_first, bool non_temporal) -> void {
+    if constexpr (is_pointer_to_trivially_copyable<Rand_it0> && std::is_pointer_v<Rand_it1>) {
+      using T0 = std::remove_cv_t<std::remove_pointer_t<Rand_it0>>;
+      using T1 = std::remove_pointer_t<Rand_it1>;
+      if constexpr (std::is_same_v<T0,T1>) {
+        if (non_temporal) return stream_copy(first,n,d_first);
+      }
+    }
+    std::copy_n(first,n,d_first);
+  }
+}
+
+
+// fill {
+template<class Rand_it, class T> auto
+fill(sequential_policy, Rand_it first, Rand_it last, const T& value) -> void {
+  using value_type = typename std::iterator_traits<Rand_it>::value_type;
+  std::ptrdiff_t n = last-first;
+  detail::fill_chunk(first,n,value,detail::use_non_temporal<value_type>(n));
+}
+template<class Rand_it, class T> auto
+fill(const parallel_policy& pol, Rand_it first, Rand_it last, const T& value) -> void {
+  using value_type = typename std::iterator_traits<Rand_it>::value_type;
+  std::ptrdiff_t n = last-first;
+  bool non_temporal = detail::use_non_temporal<value_type>(n);
+  for_each_chunk(pol,n,[&](int, std::ptrdiff_t start, std::ptrdiff_t finish){
+    detail::fill_chunk(first+start,finish-start,value,non_temporal);
+  });
+}
+// fill }
+
+
+// copy {
+/// Precondition: [first,last) and [d_first,d_first+(last-first)) do not overlap
+template<class Rand_it0, class Rand_it1> auto
+copy(sequential_policy, Rand_it0 first, Rand_it0 last, Rand_it1 d_first) -> Rand_it1 {
+  using value_type = typename std::iterator_traits<Rand_it0>::value_type;
+  std::ptrdiff_t n = last-first;
+  detail::copy_chunk(first,n,d_first,detail::use_non_temporal<value_type>(n));
+  return d_first+n;
+}
+/// Precondition: [first,last) and [d_first,d_first+(last-first)) do not overlap
+template<class Rand_it0, class Rand_it1> auto
+copy(const parallel_policy& pol, Rand_it0 first, Rand_it0 last, Rand_it1 d_first) -> Rand_it1 {
+  using value_type = typename std::iterator_traits<Rand_it0>::value_type;
+  std::ptrdiff_t n = last-first;
+  bool non_temporal = detail::use_non_temporal<value_type>(n);
+  for_each_chunk(pol,n,[&](int, std::ptrdiff_t start, std::ptrdiff_t finish){
+    detail::copy_chunk(first+start,finish-start,d_first+start,non_temporal);
+  });
+  return d_first+n;
+}
+// copy }
+
+
+// contiguous ranges {
+/**
+  Same as above, for the whole memory of a contiguous range (std::vector, buffer_vector, multi_array...)
+  For a multi_array, the whole memory is written, including the padding if any (see multi_array::memory_size())
+  Note: views of multi_arrays (block_view, strided_array, multi_arrays with a strided_layout) also have a data(),
+        but their elements are not all the elements of [data(),data()+memory_size()):
+        they are not contiguous ranges (use fill(view,value) and copy(src,dst) of contiguous_runs.hpp)
+*/
+namespace detail {
+  template<class Range> using data_t = decltype(std::declval<Range&>().data());
+  template<class Range> using memory_size_t = decltype(std::declval<const Range&>().memory_size());
+  template<class Range> using base_offset_t = decltype(std::declval<const Range&>().base_offset());
+  template<class Range> using layout_t = typename Range::shape_type::layout_type;
+
+  template<class Range> constexpr auto
+  has_strided_layout() -> bool {
+    if constexpr (is_detected_v<layout_t,Range>) {
+      return std::is_same_v<layout_t<Range>,strided_layout>;
+    } else {
+      return false;
+    }
+  }
+}
+
+/// the elements of `Range` are [data()+base_offset(),data()+base_offset()+memory_size()) if it has a memory_size(),
+/// else [data(),data()+size())
+/// A multi_array-like range with a base_offset() but no memory_size() is a view, hence not contiguous,
+/// and so is a multi_array with a strided_layout (its memory_size() includes the gaps between the elements)
+template<class Range> constexpr bool is_contiguous_range =
+     is_detected_v<detail::data_t,std::remove_reference_t<Range>>
+  && (is_detected_v<detail::memory_size_t,std::decay_t<Range>> || !is_detected_v<detail::base_offset_t,std::decay_t<Range>>)
+  && !detail::has_strided_layout<std::decay_t<Range>>();
+
+namespace detail {
+  template<class Range> auto
+  contiguous_memory_size(const Range& r) -> std::ptrdiff_t {
+    if constexpr (is_detected_v<memory_size_t,Range>) {
+      return r.memory_size();
+    } else {
+      return r.size();
+    }
+  }
+  template<class Range> auto
+  contiguous_memory_first(Range& r) {
+    if constexpr (is_detected_v<base_offset_t,std::remove_const_t<Range>>) {
+      return r.data()+r.base_offset();
+    } else {
+      return r.data();
+    }
+  }
+}
+
+template<class Policy, class Range, class T, std::enable_if_t< is_execution_policy<Policy> && is_contiguous_range<Range> , int > =0> auto
+fill(const Policy& pol, Range& r, const T& value) -> void {
+  auto* first = detail::contiguous_memory_first(r);
+  fill(pol,first,first+detail::contiguous_memory_size(r),value);
+}
+
+namespace detail {
+  template<class Policy, class Range0, class Range1> auto
+  copy_contiguous_range(const Policy& pol, const Range0& src, Range1& dst) -> void {
+    std::ptrdiff_t n = contiguous_memory_size(src);
+    STD_E_ASSERT(n==contiguous_memory_size(dst));
+    const auto* first = contiguous_memory_first(src);
+    copy(pol,first,first+n,contiguous_memory_first(dst));
+  }
+}
+// Note: the policy is not a template parameter, else the overload would be ambiguous with std_e::copy(first,last,d_first)
+/// Precondition: `src` and `dst` have the same memory size
+template<class Range0, class Range1, std::enable_if_t< is_contiguous_range<Range0> && is_contiguous_range<Range1> , int > =0> auto
+copy(sequential_policy pol, const Range0& src, Range1& dst) -> void {
+  detail::copy_contiguous_range(pol,src,dst);
+}
+/// Precondition: `src` and `dst` have the same memory size
+template<class Range0, class Range1, std::enable_if_t< is_contiguous_range<Range0> && is_contiguous_range<Range1> , int > =0> auto
+copy(const parallel_policy& pol, const Range0& src, Range1& dst) -> void {
+  detail::copy_contiguous_range(pol,src,dst);
+}
+// contiguous ranges }
+
+
+} // std_e
@@ -0,0 +1,99 @@
+#pragma once
+
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <utility>
+#include "std_e/execution/execution.hpp"
+
+
+namespace std_e {
+
+
+// Same as std::partition, but multi-threaded
+// Algorithm:
+//   1. The range is split in chunks that are partitioned independently, each by one thread
+//   2. If n_true is the total number of elements satisfying `p`,
+//        then the "true" elements are expected in [first,first+n_true)
+//        and the "false" elements are expected in [first+n_true,last).
+//      After step 1, there are as many misplaced "false" elements (in the first part) as misplaced "true" elements (in the second part)
+//   3. The misplaced elements are swapped, in parallel
+// Complexity: n applications of `p`, at most n swaps
+// Note: like std::partition, the relative order of elements is not preserved
+template<class Rand_it, class Unary_pred> auto
+// requires Rand_it is a random access iterator
+// requires Unary_pred(Rand_it::value_type)->bool
+parallel_partition(const parallel_policy& pol, Rand_it first, Rand_it last, Unary_pred p) -> Rand_it {
+  using I = typename std::iterator_traits<Rand_it>::difference_type;
+  using interval_type = std::pair<I,I>;
+
+  I n = last-first;
+  int n_chk = n_chunk(pol,n);
+  if (n_chk<=1) return std::partition(first,last,p);
+
+  // 1. partition each chunk
+  std::vector<I> starts(n_chk);
+  std::vector<I> partition_points(n_chk);
+  std::vector<I> finishes(n_chk);
+  for_each_chunk(n_chk,n,[&](int i, I start, I finish){
+    starts[i] = start;
+    finishes[i] = finish;
+    partition_points[i] = std::partition(first+start,first+finish,p) - first;
+  });
+
+  // 2. find the misplaced elements
+  I n_true = 0;
+  for (int i=0; i<n_chk; ++i) {
+    n_true += partition_points[i]-starts[i];
+  }
+  std::vector<interval_type> misplaced_false;
+  std::vector<interval_type> misplaced_true;
+  for (int i=0; i<n_chk; ++i) {
+    I false_start = partition_points[i];
+    I false_finish = std::min(finishes[i],n_true);
+    if (false_start<false_finish) misplaced_false.emplace_back(false_start,false_finish);
+
+    I true_start = std::max(starts[i],n_true);
+    I true_finish = partition_points[i];
+    if (true_start<true_finish) misplaced_true.emplace_back(true_start,true_finish);
+  }
+
+  // 3. swap the misplaced elements
+  auto interval_offsets = [](const std::vector<interval_type>& intervals){
+    std::vector<I> offsets(intervals.size()+1,0);
+    for (size_t i=0; i<intervals.size(); ++i) {
+      offsets[i+1] = offsets[i] + (intervals[i].second-intervals[i].first);
+    }
+    return offsets;
+  };
+  auto false_offsets = interval_offsets(misplaced_false);
+  auto true_offsets = interval_offsets(misplaced_true);
+  I n_misplaced = false_offsets.back(); // == true_offsets.back()
+
+  // position of the k-th misplaced element: (index of its interval, position in the range)
+  auto locate = [](const std::vector<interval_type>& intervals, const std::vector<I>& offsets, I k){
+    int i = std::upper_bound(begin(offsets),end(offsets),k) - begin(offsets) - 1;
+    return std::make_pair(i,intervals[i].first+(k-offsets[i]));
+  };
+  for_each_chunk(pol,n_misplaced,[&](int, I k_start, I k_finish){
+    if (k_start==k_finish) return;
+    auto [i_f,pos_f] = locate(misplaced_false,false_offsets,k_start);
+    auto [i_t,pos_t] = locate(misplaced_true ,true_offsets ,k_start);
+    I k = k_start;
+    while (k<k_finish) {
+      I len = std::min({k_finish-k, misplaced_false[i_f].second-pos_f, misplaced_true[i_t].second-pos_t});
+      std::swap_ranges(first+pos_f,first+pos_f+len,first+pos_t);
+      k += len;
+      pos_f += len;
+      pos_t += len;
+      if (pos_f==misplaced_false[i_f].second && k<k_finish) { ++i_f; pos_f = misplaced_false[i_f].first; }
+      if (pos_t==misplaced_true [i_t].second && k<k_finish) { ++i_t; pos_t = misplaced_true [i_t].first; }
+    }
+  });
+
+  return first+n_true;
+}
+
+
+} // std_e
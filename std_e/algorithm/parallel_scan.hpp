@@ -0,0 +1,82 @@
+#pragma once
+
+
+#include <iterator>
+#include <numeric>
+#include <vector>
+#include "std_e/execution/execution.hpp"
+#include "std_e/future/algorithm.hpp"
+#include "std_e/algorithm/numerics.hpp"
+
+
+namespace std_e {
+
+
+/**
+  Same as std_e::inclusive_scan, std_e::exclusive_scan and std_e::partial_accumulate, but multi-threaded
+  Algorithm:
+    1. The range is split in chunks that are reduced independently, each by one thread
+    2. The chunk reductions are scanned sequentially: this gives the initial value of each chunk
+    3. Each chunk is scanned independently, starting from its initial value
+       (with the SIMD scan of future/algorithm.hpp if possible)
+  Complexity: 2n applications of `op`, n reads and n writes in the second pass
+  Note: `op` must be associative
+  Note: [first,last) and [d_first,...) may be the same range
+*/
+namespace detail {
+  template<bool inclusive, class Rand_it0, class Rand_it1, class T, class Binary_op> auto
+  parallel_scan(const parallel_policy& pol, Rand_it0 first, Rand_it0 last, Rand_it1 d_first, T init, Binary_op op) -> Rand_it1 {
+    using I = typename std::iterator_traits<Rand_it0>::difference_type;
+    I n = last-first;
+    int n_chk = n_chunk(pol,n);
+    if (n_chk<=1) {
+      if constexpr (inclusive) return std_e::inclusive_scan(first,last,d_first,op,init);
+      else                     return std_e::exclusive_scan(first,last,d_first,init,op);
+    }
+
+    // 1. reduce each chunk (chunks are not empty)
+    std::vector<T> chunk_inits(n_chk,init);
+    for_each_chunk(n_chk,n,[&](int i, I start, I finish){
+      if (i<n_chk-1) chunk_inits[i+1] = std::accumulate(first+start+1,first+finish,T(first[start]),op);
+    });
+
+    // 2. scan the chunk reductions
+    for (int i=1; i<n_chk; ++i) {
+      chunk_inits[i] = op(chunk_inits[i-1],chunk_inits[i]);
+    }
+
+    // 3. scan each chunk
+    for_each_chunk(n_chk,n,[&](int i, I start, I finish){
+      if constexpr (inclusive) std_e::inclusive_scan(first+start,first+finish,d_first+start,op,chunk_inits[i]);
+      else                     std_e::exclusive_scan(first+start,first+finish,d_first+start,chunk_inits[i],op);
+    });
+    return d_first+n;
+  }
+}
+
+template<class Rand_it0, class Rand_it1, class Binary_op, class T> auto
+inclusive_scan(const parallel_policy& pol, Rand_it0 first, Rand_it0 last, Rand_it1 d_first, Binary_op op, T init) -> Rand_it1 {
+  return detail::parallel_scan<true>(pol,first,last,d_first,init,op);
+}
+template<class Rand_it0, class Rand_it1, class Binary_op = std::plus<>> auto
+inclusive_scan(const parallel_policy& pol, Rand_it0 first, Rand_it0 last, Rand_it1 d_first, Binary_op op = {}) -> Rand_it1 {
+  if (first==last) return d_first;
+  auto init = *first;
+  *d_first = init;
+  return detail::parallel_scan<true>(pol,first+1,last,d_first+1,init,op);
+}
+
+template<class Rand_it0, class Rand_it1, class T, class Binary_op = std::plus<>> auto
+exclusive_scan(const parallel_policy& pol, Rand_it0 first, Rand_it0 last, Rand_it1 d_first, T init, Binary_op op = {}) -> Rand_it1 {
+  return detail::parallel_scan<false>(pol,first,last,d_first,init,op);
+}
+
+template<class Rand_it0, class Rand_it1, class T, class Binary_op = std::plus<>> auto
+partial_accumulate(const parallel_policy& pol, Rand_it0 first, Rand_it0 last, Rand_it1 d_first, const T& init, Binary_op op = {}) -> Rand_it1 {
+  // Precondition: [d_first,d_first+n+1) valid range where n = last-first
+  *d_first = init;
+  return detail::parallel_scan<true>(pol,first,last,d_first+1,init,op);
+}
+
+
+} // std_e
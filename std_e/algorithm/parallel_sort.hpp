@@ -0,0 +1,113 @@
+#pragma once
+
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include "std_e/execution/execution.hpp"
+
+
+namespace std_e {
+
+
+// merge tasks {
+namespace detail {
+  template<class It, class Out_it>
+  struct merge_task {
+    It first0, last0;
+    It first1, last1;
+    Out_it d_first;
+  };
+
+  /// Splits the stable merge of [first0,last0) and [first1,last1) into `n_piece` independent merges
+  /// The first range is cut evenly, the second range is cut accordingly (by binary search)
+  template<class It, class Out_it, class Comp> auto
+  split_merge(It first0, It last0, It first1, It last1, Out_it d_first, int n_piece, Comp comp, std::vector<merge_task<It,Out_it>>& tasks) -> void {
+    auto n0 = last0-first0;
+    It prev0 = first0;
+    It prev1 = first1;
+    for (int k=1; k<=n_piece; ++k) {
+      It cut0 = k<n_piece ? first0 + n0*k/n_piece : last0;
+      // elements of the second range that are equal to *cut0 must go after it (stability)
+      It cut1 = k<n_piece ? std::lower_bound(prev1,last1,*cut0,comp) : last1;
+      tasks.push_back({prev0,cut0,prev1,cut1,d_first+(prev0-first0)+(prev1-first1)});
+      prev0 = cut0;
+      prev1 = cut1;
+    }
+  }
+}
+// merge tasks }
+
+
+/**
+  Same as std::stable_sort, but multi-threaded
+  Algorithm:
+    1. The range is split in chunks that are sorted independently, each by one thread
+    2. Sorted runs are merged two by two, into a buffer, then back, until only one run is left
+       Each merge is itself split into independent pieces so that all threads are busy,
+       even for the last merges
+  Complexity: O(n log(n)) comparisons, O(n log(n_thread)) moves
+  Requires one buffer of `n` elements
+*/
+template<class Rand_it, class Comp = std::less<>> auto
+// requires Rand_it is a random access iterator
+parallel_stable_sort(const parallel_policy& pol, Rand_it first, Rand_it last, Comp comp = {}) -> void {
+  using I = typename std::iterator_traits<Rand_it>::difference_type;
+  using T = typename std::iterator_traits<Rand_it>::value_type;
+
+  I n = last-first;
+  int n_chk = n_chunk(pol,n);
+  if (n_chk<=1) return std::stable_sort(first,last,comp);
+
+  // 1. sort each chunk
+  std::vector<I> run_bounds(n_chk+1);
+  for_each_chunk(n_chk,n,[&](int i, I start, I finish){
+    run_bounds[i] = start;
+    if (i==n_chk-1) run_bounds[n_chk] = finish;
+    std::stable_sort(first+start,first+finish,comp);
+  });
+
+  // 2. merge the runs
+  std::vector<T> buf(n);
+  auto merge_round = [&](auto src, auto dst){
+    using src_it = decltype(src);
+    using dst_it = decltype(dst);
+    int n_run = run_bounds.size()-1;
+    int n_merge = n_run/2;
+    int n_piece = std::max(1,pol.n_thread/std::max(n_merge,1));
+
+    std::vector<detail::merge_task<src_it,dst_it>> tasks;
+    std::vector<I> new_bounds = {0};
+    for (int r=0; r+1<n_run; r+=2) {
+      detail::split_merge(src+run_bounds[r],src+run_bounds[r+1],src+run_bounds[r+1],src+run_bounds[r+2],dst+run_bounds[r],n_piece,comp,tasks);
+      new_bounds.push_back(run_bounds[r+2]);
+    }
+    if (n_run%2==1) { // odd run out: copied as is
+      tasks.push_back({src+run_bounds[n_run-1],src+run_bounds[n_run],src+run_bounds[n_run],src+run_bounds[n_run],dst+run_bounds[n_run-1]});
+      new_bounds.push_back(run_bounds[n_run]);
+    }
+
+    for_each_chunk((int)tasks.size(),(int)tasks.size(),[&](int, int start, int finish){
+      for (int t=start; t<finish; ++t) {
+        auto& tk = tasks[t];
+        std::merge(std::make_move_iterator(tk.first0),std::make_move_iterator(tk.last0),
+                   std::make_move_iterator(tk.first1),std::make_move_iterator(tk.last1),
+                   tk.d_first,comp);
+      }
+    });
+    run_bounds = std::move(new_bounds);
+  };
+
+  bool in_buf = false;
+  while (run_bounds.size() > 2) {
+    if (in_buf) merge_round(begin(buf),first);
+    else        merge_round(first,begin(buf));
+    in_buf = !in_buf;
+  }
+  if (in_buf) {
+    std::move(begin(buf),end(buf),first);
+  }
+}
+
+
+} // std_e
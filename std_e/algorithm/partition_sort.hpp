@@ -2,8 +2,13 @@
 
 #include <algorithm>
 #include <functional>
+#include <numeric>
+#include <type_traits>
 #include "std_e/data_structure/jagged_range.hpp"
 #include "std_e/algorithm/mismatch_points.hpp"
+#include "std_e/algorithm/parallel_partition.hpp"
+#include "std_e/algorithm/permutation.hpp"
+#include "std_e/execution/execution.hpp"
 
 
 namespace std_e {
@@ -51,13 +56,142 @@ partition_sort_indices__impl(Rand_it0 first, Rand_it0 last, Rand_it1 pv_first, R
     partition_sort_indices__impl(pp_mid,last   , pv_mid  ,pv_last , pi_mid   , comp, start);
   }
 }
+
+
+// Bucket engine
+// Same result as partition_sort_indices__impl, but with a single data movement instead of log_2(k):
+//    - for each element, find its bucket (i.e. the number of partition values it is not less than)
+//        by a binary search over [pv_first,pv_last). The search is branchless, so it is not penalized by unpredictable comparisons
+//    - count the number of elements in each bucket. Their exclusive scan gives the partition indices
+//    - scatter the elements into a buffer at their bucket position, then move them back
+// Complexity: n*log_2(k) comparisons, but only 3n moves (instead of n*log_2(k) swaps), plus 2 n-sized buffers
+// Note: contrary to partition_sort_indices__impl, the relative order of elements in each partition is preserved
+template<class T, class Rand_it, class Bin_pred> constexpr auto
+partition_bucket(const T& x, Rand_it pv_first, int k, Bin_pred comp) -> int {
+  // Precondition: k>0
+  Rand_it base = pv_first;
+  int len = k;
+  while (len>1) {
+    int half = len/2;
+    base = comp(x,base[half]) ? base : base+half; // compiled to a conditional move
+    len -= half;
+  }
+  return (base-pv_first) + !comp(x,*base);
+}
+template<class Rand_it0, class Rand_it1, class Rand_it2, class Bin_pred> auto
+bucket_partition_sort_indices__impl(Rand_it0 first, Rand_it0 last, Rand_it1 pv_first, Rand_it1 pv_last, Rand_it2 pi_first, Bin_pred comp, Rand_it0 start) -> void {
+  using T = typename std::iterator_traits<Rand_it0>::value_type;
+  using I = typename std::iterator_traits<Rand_it0>::difference_type;
+  int k = pv_last-pv_first;
+  if (k==0) return;
+  I n = last-first;
+
+  std::vector<int> buckets(n);
+  std::vector<I> bucket_offsets(k+2,0);
+  for (I i=0; i<n; ++i) {
+    buckets[i] = partition_bucket(first[i],pv_first,k,comp);
+    ++bucket_offsets[buckets[i]+1];
+  }
+  std::partial_sum(begin(bucket_offsets),end(bucket_offsets),begin(bucket_offsets));
+
+  I off = first-start;
+  for (int j=0; j<k; ++j) {
+    pi_first[j] = off + bucket_offsets[j+1];
+  }
+
+  std::vector<T> buffer(n);
+  for (I i=0; i<n; ++i) {
+    buffer[bucket_offsets[buckets[i]]++] = std::move(first[i]);
+  }
+  std::move(begin(buffer),end(buffer),first);
+}
+template<class Rand_it0, class Rand_it1, class Rand_it2, class Bin_pred = std::less<>> auto
+bucket_partition_sort_indices(Rand_it0 first, Rand_it0 last, Rand_it1 pv_first, Rand_it1 pv_last, Rand_it2 pi_first, Bin_pred comp = {}) -> void {
+  return bucket_partition_sort_indices__impl(first,last,pv_first,pv_last,pi_first,comp,first);
+}
+
+
+// Engine selection
+// The bucket engine pays for its allocations and binary searches, so it is only worth it for enough partition values
+// Thresholds measured on random integers (see algorithm/bench/partition_sort.bench.cpp)
+template<class T, class I> constexpr auto
+use_bucket_partition_sort(I n, I k) -> bool {
+  if constexpr (!std::is_default_constructible_v<T> || !std::is_move_assignable_v<T>) {
+    return false;
+  } else {
+    return k>=64 || (k>=8 && n>=(1<<15));
+  }
+}
+template<class Rand_it0, class Rand_it1, class Rand_it2, class Bin_pred> constexpr auto
+partition_sort_indices__select(Rand_it0 first, Rand_it0 last, Rand_it1 pv_first, Rand_it1 pv_last, Rand_it2 pi_first, Bin_pred comp, Rand_it0 start) -> void {
+  using T = typename std::iterator_traits<Rand_it0>::value_type;
+  using I = typename std::iterator_traits<Rand_it0>::difference_type;
+  if (use_bucket_partition_sort<T>(I(last-first),I(pv_last-pv_first))) {
+    return bucket_partition_sort_indices__impl(first,last,pv_first,pv_last,pi_first,comp,start);
+  } else {
+    return partition_sort_indices__impl(first,last,pv_first,pv_last,pi_first,comp,start);
+  }
+}
 template<class Rand_it0, class Rand_it1, class Rand_it2, class Bin_pred = std::less<>> constexpr auto
 partition_sort_indices(Rand_it0 first, Rand_it0 last, Rand_it1 pv_first, Rand_it1 pv_last, Rand_it2 pi_first, Bin_pred comp = {}) -> void {
-  return partition_sort_indices__impl(first,last,pv_first,pv_last,pi_first,comp,first);
+  return partition_sort_indices__select(first,last,pv_first,pv_last,pi_first,comp,first);
+}
+
+
+
+// Parallel versions
+// The two recursive calls are independent, so they are run concurrently
+// The thread budget is split between both sides proportionally to their number of elements
+// While a sub-problem has several threads, its partition is itself done with parallel_partition
+// Sub-problems of less than pol.grain_size elements are solved sequentially
+namespace detail {
+  /// number of threads given to the left side, out of `n_thread>=2`, if it has `n_left` of the `n` elements
+  /// each side gets at least one thread, so that both together use exactly `n_thread`
+  template<class I> auto
+  n_thread_of_left_side(int n_thread, I n_left, I n) -> int {
+    int n_thread_left = (n_thread*n_left + n/2) / n;
+    return std::clamp(n_thread_left,1,n_thread-1);
+  }
+}
+template<class Rand_it0, class Rand_it1, class Rand_it2, class Bin_pred> auto
+partition_sort_indices__impl(const parallel_policy& pol, Rand_it0 first, Rand_it0 last, Rand_it1 pv_first, Rand_it1 pv_last, Rand_it2 pi_first, Bin_pred comp, Rand_it0 start) -> void {
+  if (pv_first==pv_last) return;
+  auto n = last-first;
+  if (pol.n_thread<=1 || n<pol.grain_size) {
+    return partition_sort_indices__select(first,last,pv_first,pv_last,pi_first,comp,start);
+  }
+  auto k = pv_last-pv_first;
+  auto pv_mid = pv_first+k/2;
+  auto pi_mid = pi_first+k/2;
+  auto pp_mid = parallel_partition(pol,first,last,[mid=*pv_mid,comp](const auto& x){ return comp(x,mid); });
+  *pi_mid = pp_mid - start;
+  if (k>1) {
+    int n_thread_left = detail::n_thread_of_left_side(pol.n_thread,pp_mid-first,n);
+    auto pol_left  = with_n_thread(pol,n_thread_left);
+    auto pol_right = with_n_thread(pol,pol.n_thread-n_thread_left);
+    fork_join(
+      [=](){ partition_sort_indices__impl(pol_left ,first ,pp_mid , pv_first,pv_mid  , pi_first , comp, start); },
+      [=](){ partition_sort_indices__impl(pol_right,pp_mid,last   , pv_mid  ,pv_last , pi_mid   , comp, start); }
+    );
+  }
+}
+template<class Rand_it0, class Rand_it1, class Rand_it2, class Bin_pred = std::less<>> auto
+partition_sort_indices(const parallel_policy& pol, Rand_it0 first, Rand_it0 last, Rand_it1 pv_first, Rand_it1 pv_last, Rand_it2 pi_first, Bin_pred comp = {}) -> void {
+  return partition_sort_indices__impl(pol,first,last,pv_first,pv_last,pi_first,comp,first);
+}
+template<class Rand_it0, class Rand_it1, class Rand_it2, class Bin_pred = std::less<>> auto
+partition_sort(const parallel_policy& pol, Rand_it0 first, Rand_it0 last, Rand_it1 pv_first, Rand_it1 pv_last, Rand_it2 pp_first, Bin_pred comp = {}) -> void {
+  auto k = pv_last-pv_first;
+  std::vector<typename std::iterator_traits<Rand_it0>::difference_type> partition_indices(k);
+  partition_sort_indices(pol,first,last,pv_first,pv_last,begin(partition_indices),comp);
+  std::transform(begin(partition_indices),end(partition_indices),pp_first,[first](auto i){ return first+i; });
 }
 
 
-template<class Rand_range0, class Rand_range1, class Bin_pred = std::less<>> constexpr auto
+template<
+  class Rand_range0, class Rand_range1, class Bin_pred = std::less<>,
+  std::enable_if_t<!is_execution_policy<Rand_range0>,int> =0
+> constexpr auto
 partition_sort(Rand_range0& rng, const Rand_range1& partition_values, Bin_pred comp = {}) {
   using it_type = typename Rand_range0::iterator;
   std::vector<it_type> partition_points(partition_values.size());
@@ -65,7 +199,10 @@ partition_sort(Rand_range0& rng, const Rand_range1& partition_values, Bin_pred c
   return partition_points;
 }
 
-template<class Rand_range0, class Rand_range1, class Bin_pred = std::less<>> auto
+template<
+  class Rand_range0, class Rand_range1, class Bin_pred = std::less<>,
+  std::enable_if_t<!is_execution_policy<Rand_range0>,int> =0
+> auto
 partition_sort_indices(Rand_range0& rng, const Rand_range1& partition_values, Bin_pred comp = {}) -> std::vector<int> {
   int k = partition_values.size();
   std::vector<int> partition_indices(1+k);
@@ -74,28 +211,195 @@ partition_sort_indices(Rand_range0& rng, const Rand_range1& partition_values, Bi
   return partition_indices;
 }
 
+template<class Rand_range0, class Rand_range1, class Bin_pred = std::less<>> auto
+partition_sort(const parallel_policy& pol, Rand_range0& rng, const Rand_range1& partition_values, Bin_pred comp = {}) {
+  using it_type = typename Rand_range0::iterator;
+  std::vector<it_type> partition_points(partition_values.size());
+  partition_sort(pol,begin(rng),end(rng),begin(partition_values),end(partition_values),begin(partition_points),comp);
+  return partition_points;
+}
+template<class Rand_range0, class Rand_range1, class Bin_pred = std::less<>> auto
+partition_sort_indices(const parallel_policy& pol, Rand_range0& rng, const Rand_range1& partition_values, Bin_pred comp = {}) -> std::vector<int> {
+  int k = partition_values.size();
+  std::vector<int> partition_indices(1+k);
+  partition_indices[0] = 0;
+  partition_sort_indices(pol,begin(rng),end(rng),begin(partition_values),end(partition_values),begin(partition_indices)+1,comp);
+  return partition_indices;
+}
+
 
-// TODO extract in iterator-level interface
-// TODO if passed list of possible values, use partition_sort, else use std::sort
-// TODO distinguish between cheap and costly swap of T
-//    Here, assumed costly -> indirect sort
-//    If swap is cheap (e.g. T is built-in), then the sort can be inplace
-// TODO distinguish between cheap and costly "proj"
-//    Here, we assume "proj" is costly, so we save the result
-//    It "proj" is cheap, (e.g. access to an attribute) then we can compute it on-the-fly
-template<class Range, class F, class T = typename Range::value_type> auto
-sort_into_partitions(Range&& rng, F proj) -> jagged_vector<T> {
-  auto&& compared_values = std_e::transform(rng,proj);
-  auto sort_permutation = std_e::sort_permutation(compared_values);
+// sort_into_partitions {
+/**
+  sort_into_partitions(rng,proj) sorts `rng` by increasing `proj(x)`, and returns it as a jagged_vector
+  where each sub-range holds the elements of equal `proj(x)` (the sort is stable)
+    - `proj` is assumed to be costly, so it is called only once by element, and the keys are saved
+    - if the keys are small integers (or enums), that is, if their range [k_min,k_max] is not bigger than the range to sort,
+      they are sorted by counting sort, which is linear. The elements are then permuted in place
+      (or, if they are small and trivially copyable, scattered to their sorted position in a new vector, which is faster
+      and uses no more memory than the permutation, then copied back to `rng`, unless `rng` is a vector that is moved in)
+      Else, the keys are sorted by sort_permutation, and the elements are permuted in place
+    - the parallel version does the same by chunks (with one counting sort histogram by chunk)
+*/
+namespace detail {
+  /// the keys are stored as bytes instead of bool, so that they can be written concurrently
+  template<class K> using partition_key_t = std::conditional_t<std::is_same_v<K,bool>,unsigned char,K>;
 
-  auto partition_indices = std_e::mismatch_indices(
-    sort_permutation,
-    [&compared_values](int i, int j){ return compared_values[i] == compared_values[j]; }
-  );
+  template<class K> constexpr bool is_counting_sortable = std::is_integral_v<K> || std::is_enum_v<K>;
 
-  permute(rng,sort_permutation);
-  return {FWD(rng),std::move(partition_indices)};
+  template<class K, bool = std::is_enum_v<K>> struct integer_key { using type = K; };
+  template<class K> struct integer_key<K,true> { using type = std::underlying_type_t<K>; };
+
+  /// Precondition: k_min <= k
+  template<class K> auto
+  bucket_of(K k, K k_min) -> std::size_t {
+    using I = typename integer_key<K>::type;
+    using U = std::make_unsigned_t<I>;
+    return U(U(static_cast<I>(k)) - U(static_cast<I>(k_min))); // unsigned difference: no overflow, even for signed keys
+  }
+
+  /// The elements are scattered into a new vector only if it is not bigger than the permutation used to sort them in place
+  template<class T> constexpr bool scatter_into_partitions =
+    std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && sizeof(T)<=sizeof(int);
+
+  /// the histograms of the counting sort should not be bigger than the range to sort
+  inline auto
+  use_counting_sort(std::size_t max_bucket, int n_by_chunk) -> bool {
+    return max_bucket < std::max(std::size_t(n_by_chunk),std::size_t(1)<<10);
+  }
+
+  template<class K, class Range, class F> auto
+  partition_keys(int n_chk, const Range& rng, F& proj) -> std::vector<K> {
+    int n = rng.size();
+    std::vector<K> keys(n);
+    for_each_chunk(n_chk,n,[&](int, int start, int finish){
+      for (int i=start; i<finish; ++i) {
+        keys[i] = proj(rng[i]);
+      }
+    });
+    return keys;
+  }
+  /// Precondition: keys.size()>0
+  template<class K> auto
+  key_range(int n_chk, const std::vector<K>& keys) -> std::pair<K,K> {
+    int n = keys.size();
+    std::vector<std::pair<K,K>> chunk_ranges(n_chk,{keys[0],keys[0]});
+    for_each_chunk(n_chk,n,[&](int c, int start, int finish){
+      if (start<finish) {
+        auto [min_it,max_it] = std::minmax_element(begin(keys)+start,begin(keys)+finish);
+        chunk_ranges[c] = {*min_it,*max_it};
+      }
+    });
+    std::pair<K,K> res = chunk_ranges[0];
+    for (const auto& [k_min,k_max] : chunk_ranges) {
+      res.first  = std::min(res.first ,k_min);
+      res.second = std::max(res.second,k_max);
+    }
+    return res;
+  }
+
+  /// Counting sort of the keys
+  /// Returns, for each chunk `c` and bucket `b`, the sorted position of the first element of `b` in `c` (at offsets[c*n_bucket+b])
+  /// The elements of bucket `b` of chunk `c` are placed after the ones of the previous chunks, so that the sort is stable
+  /// The partition indices of the non-empty buckets are appended to `partition_indices`
+  template<class K> auto
+  counting_sort_offsets(int n_chk, const std::vector<K>& keys, K k_min, std::size_t n_bucket, std::vector<int>& partition_indices) -> std::vector<int> {
+    int n = keys.size();
+    std::vector<int> offsets(n_chk*n_bucket,0);
+    for_each_chunk(n_chk,n,[&](int c, int start, int finish){
+      int* counts = offsets.data()+c*n_bucket;
+      for (int i=start; i<finish; ++i) {
+        ++counts[bucket_of(keys[i],k_min)];
+      }
+    });
+    int pos = 0;
+    for (std::size_t b=0; b<n_bucket; ++b) {
+      int bucket_start = pos;
+      for (int c=0; c<n_chk; ++c) {
+        int count = offsets[c*n_bucket+b];
+        offsets[c*n_bucket+b] = pos;
+        pos += count;
+      }
+      if (pos>bucket_start) {
+        partition_indices.push_back(pos);
+      }
+    }
+    return offsets;
+  }
+}
+
+namespace detail {
+  template<class T, class Policy, class Range, class F> auto
+  sort_into_partitions__impl(const Policy& pol, Range&& rng, F& proj) -> jagged_vector<T> {
+    using K = partition_key_t<std::decay_t<std::invoke_result_t<F&,const T&>>>;
+    constexpr bool is_parallel = std::is_same_v<Policy,parallel_policy>;
+    int n = rng.size();
+    int n_chk = 1;
+    if constexpr (is_parallel) {
+      n_chk = n_chunk(pol,n);
+    }
+    auto keys = partition_keys<K>(n_chk,rng,proj);
+    if constexpr (is_counting_sortable<K>) {
+      if (n==0) return {FWD(rng),std::vector<int>{0}};
+      auto [k_min,k_max] = key_range(n_chk,keys);
+      std::size_t max_bucket = bucket_of(k_max,k_min);
+      if (use_counting_sort(max_bucket,n/n_chk)) {
+        std::vector<int> partition_indices = {0};
+        std::size_t n_bucket = max_bucket+1;
+        auto offsets = counting_sort_offsets(n_chk,keys,k_min,n_bucket,partition_indices);
+        if constexpr (scatter_into_partitions<T>) {
+          // scatter each element to its sorted position
+          std::vector<T> sorted(n);
+          for_each_chunk(n_chk,n,[&](int c, int start, int finish){
+            int* chunk_offsets = offsets.data()+c*n_bucket;
+            for (int i=start; i<finish; ++i) {
+              sorted[chunk_offsets[bucket_of(keys[i],k_min)]++] = std::move(rng[i]);
+            }
+          });
+          if constexpr (std::is_same_v<Range,std::vector<T>>) { // rvalue vector: no one sees it again
+            return {std::move(sorted),std::move(partition_indices)};
+          } else { // same side effect as the in-place permutation
+            std::copy(begin(sorted),end(sorted),begin(rng));
+            return {FWD(rng),std::move(partition_indices)};
+          }
+        } else {
+          // in place: the only n-sized buffers are the keys and the permutation (the keys are released before the permutation)
+          std::vector<int> sort_permutation(n);
+          for_each_chunk(n_chk,n,[&](int c, int start, int finish){
+            int* chunk_offsets = offsets.data()+c*n_bucket;
+            for (int i=start; i<finish; ++i) {
+              sort_permutation[chunk_offsets[bucket_of(keys[i],k_min)]++] = i;
+            }
+          });
+          keys = {};
+          offsets = {};
+          permute(begin(rng),sort_permutation);
+          return {FWD(rng),std::move(partition_indices)};
+        }
+      }
+    }
+    std::vector<int> sort_permutation;
+    if constexpr (is_parallel) {
+      sort_permutation = std_e::sort_permutation(pol,keys); // stable
+    } else if constexpr (is_small_key<K>) {
+      sort_permutation = std_e::sort_permutation(keys); // stable for small keys
+    } else {
+      sort_permutation = std_e::sort_permutation(keys,std::less<>{},[](auto first, auto last, auto comp){ std::stable_sort(first,last,comp); });
+    }
+    auto partition_indices = std_e::mismatch_indices(sort_permutation,[&keys](int i, int j){ return keys[i] == keys[j]; });
+    permute(begin(rng),sort_permutation);
+    return {FWD(rng),std::move(partition_indices)};
+  }
+}
+
+template<class Range, class F, class T = typename Range::value_type> auto
+sort_into_partitions(Range&& rng, F proj) -> jagged_vector<T> {
+  return detail::sort_into_partitions__impl<T>(seq,FWD(rng),proj);
+}
+template<class Range, class F, class T = typename Range::value_type> auto
+sort_into_partitions(const parallel_policy& pol, Range&& rng, F proj) -> jagged_vector<T> {
+  return detail::sort_into_partitions__impl<T>(pol,FWD(rng),proj);
 }
+// sort_into_partitions }
 
 
 } // std_e
@@ -5,6 +5,14 @@
 #include <algorithm>
 #include <numeric>
 #include <tuple>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <memory>
+#include "std_e/execution/execution.hpp"
+#include "std_e/algorithm/parallel_sort.hpp"
+#include "std_e/algorithm/radix_sort.hpp"
+#include "std_e/utils/functional.hpp"
 
 
 namespace std_e {
@@ -30,6 +38,7 @@ inverse_partial_permutation(const Random_access_container& p, index_type sz, ind
   return inv_p;
 }
 
+
 template<class array_type> constexpr auto
 compose_permutations(const array_type& p0, const array_type& p1) {
   // Precond p0 and p1 are compatible permutations ( i.e. image(p0) in domain(p1)=[0,size(p1)[ )
@@ -49,13 +58,112 @@ compose_permutations(const array_type& p0, const array_type& p1) {
 //  return p;
 //}
 constexpr auto std_sort_lambda = [](auto f, auto l, auto comp){ std::sort(f,l,comp); };
-template<class Rng, class Comp = std::less<>, class sort_algo_type = decltype(std_sort_lambda)> auto
+
+// sort_permutation {
+/**
+  Permutation p such that x[p[0]],x[p[1]],... is sorted by `comp(key(x[i]),key(x[j]))`
+  Three engines:
+    - if the key is small and trivially copyable, (key,index) pairs are sorted:
+      the comparisons access contiguous memory instead of dereferencing x at random
+      The result is then stable (equivalent elements keep their relative order)
+    - moreover, if the key is an integer and `comp` is std::less or std::greater,
+      the pairs are radix-sorted (linear complexity) for large enough ranges
+      (also for floating point keys if `sort_algo` is `radix_sort_algo`)
+    - otherwise, indices are sorted with an indirect comparator
+  A custom `sort_algo` is only given the indirect comparator,
+  since it may expect iterators over indices
+*/
+namespace detail {
+  template<class K>
+  struct key_index {
+    K key;
+    int index;
+  };
+
+  template<class K> constexpr bool is_small_key =
+       std::is_trivially_copyable_v<K>
+    && std::is_default_constructible_v<K>
+    && sizeof(K)<=16;
+
+  template<class Rng, class Key> using key_type = std::decay_t<std::invoke_result_t<const Key&,decltype(std::declval<const Rng&>()[0])>>;
+
+  template<class K, class Rng, class Key> auto
+  key_indices(const Rng& x, const Key& key) -> std::vector<key_index<K>> {
+    int n = x.size();
+    std::vector<key_index<K>> kis(n);
+    for (int i=0; i<n; ++i) {
+      kis[i] = {key(x[i]),i};
+    }
+    return kis;
+  }
+  template<class K> auto
+  indices(const std::vector<key_index<K>>& kis) -> std::vector<int> {
+    std::vector<int> p(kis.size());
+    std::transform(begin(kis),end(kis),begin(p),[](const auto& ki){ return ki.index; });
+    return p;
+  }
+
+  /// 1 if `Comp` sorts keys by increasing order, -1 if by decreasing order, 0 if unknown
+  template<class Comp, class K> constexpr int radix_order =
+      (std::is_same_v<Comp,std::less<>>    || std::is_same_v<Comp,std::less<K>>   ) ?  1
+    : (std::is_same_v<Comp,std::greater<>> || std::is_same_v<Comp,std::greater<K>>) ? -1
+    : 0;
+  // below this size, std::sort is faster than the radix sort passes
+  constexpr int radix_sort_permutation_min_size = 512;
+}
+
+template<class Rng, class Key, class Comp = std::less<>, class sort_algo_type = decltype(std_sort_lambda)> auto
+sort_permutation_by_key(const Rng& x, Key key, Comp comp = {}, sort_algo_type sort_algo = std_sort_lambda) -> std::vector<int> {
+  using K = detail::key_type<Rng,Key>;
+  using algo = std::decay_t<sort_algo_type>;
+  constexpr bool is_std_sort = std::is_same_v<algo,std::decay_t<decltype(std_sort_lambda)>>;
+  constexpr bool is_radix_sort = std::is_same_v<algo,radix_sort_algo_type>;
+  constexpr int order = detail::radix_order<Comp,K>;
+  if constexpr (detail::is_small_key<K> && (is_std_sort || is_radix_sort)) {
+    auto kis = detail::key_indices<K>(x,key);
+    if constexpr (is_radix_sortable<K> && order!=0 && (is_radix_sort || std::is_integral_v<K>)) {
+      if (is_radix_sort || int(kis.size())>=detail::radix_sort_permutation_min_size) {
+        radix_sort(begin(kis), end(kis), [](const auto& ki){ return order==1 ? radix_bits(ki.key) : radix_bits_t<K>(~radix_bits(ki.key)); });
+        return detail::indices(kis);
+      }
+    }
+    // the index breaks ties, so that the result is stable
+    std::sort(begin(kis), end(kis), [&](const auto& a, const auto& b){
+      return comp(a.key,b.key) || (!comp(b.key,a.key) && a.index<b.index);
+    });
+    return detail::indices(kis);
+  } else {
+    std::vector<int> p(x.size());
+    std::iota(begin(p), end(p), 0);
+    sort_algo(begin(p), end(p), [&](int i, int j){ return comp(key(x[i]), key(x[j])); });
+    return p;
+  }
+}
+template<class Rng, class Comp = std::less<>, class sort_algo_type = decltype(std_sort_lambda), std::enable_if_t<!is_execution_policy<Rng>,int> =0> auto
 sort_permutation(const Rng& x, Comp comp = {}, sort_algo_type sort_algo = std_sort_lambda) -> std::vector<int> {
-  std::vector<int> p(x.size());
-  std::iota(begin(p), end(p), 0);
-  sort_algo(begin(p), end(p), [&](int i, int j){ return comp(x[i], x[j]); });
-  return p;
+  return sort_permutation_by_key(x,identity,comp,sort_algo);
+}
+
+/// Same as the sequential versions, but multi-threaded (parallel stable merge sort). The result is stable
+template<class Rng, class Key, class Comp = std::less<>> auto
+sort_permutation_by_key(const parallel_policy& pol, const Rng& x, Key key, Comp comp = {}) -> std::vector<int> {
+  using K = detail::key_type<Rng,Key>;
+  if constexpr (detail::is_small_key<K>) {
+    auto kis = detail::key_indices<K>(x,key);
+    parallel_stable_sort(pol, begin(kis), end(kis), [&](const auto& a, const auto& b){ return comp(a.key,b.key); });
+    return detail::indices(kis);
+  } else {
+    std::vector<int> p(x.size());
+    std::iota(begin(p), end(p), 0);
+    parallel_stable_sort(pol, begin(p), end(p), [&](int i, int j){ return comp(key(x[i]), key(x[j])); });
+    return p;
+  }
 }
+template<class Rng, class Comp = std::less<>> auto
+sort_permutation(const parallel_policy& pol, const Rng& x, Comp comp = {}) -> std::vector<int> {
+  return sort_permutation_by_key(pol,x,identity,comp);
+}
+// sort_permutation }
 template<class Rng, class Comp = std::equal_to<>> auto
 unique_permutation(const Rng& x, Comp comp = {}) -> std::vector<int> {
   std::vector<int> p(x.size());
@@ -87,27 +195,161 @@ permute_copy(const std::vector<T>& v, const std::vector<I>& p) -> std::vector<T>
 }
 
 
+// blocked gather {
+/**
+  Policy for gathering through an index array that is too big to fit in cache
+  (i.e. w[i] = v[p[i]] with p random, v and w larger than the last level cache)
+
+  The direct gather does one random read per element, that is, one cache miss (and often one TLB miss).
+  The blocked gather trades these misses for sequential passes:
+    1. the (destination,source) index pairs are bucketed by source block
+    2. each source block is read through its bucket (the block stays in cache),
+       and the (destination,value) pairs are bucketed by destination block
+    3. each destination block is written through its bucket (the block stays in cache)
+  Each bucketing pass writes to `n/block_size` streams: `block_size` should be large enough
+  for the stream heads to stay in L1, and small enough for a block to stay in L2.
+
+  Its cost is three passes and two buffers of `n` pairs,
+  so it only pays for sizes well above the last level cache
+  (see the "permutation/permute_copy" benchmarks for the crossover on a given machine)
+*/
+struct direct_gather_policy {};
+struct blocked_gather_policy {
+  std::ptrdiff_t block_size = 1<<16; // number of elements, rounded up to a power of two
+};
+
+inline constexpr direct_gather_policy direct_gather = {};
+inline constexpr blocked_gather_policy blocked_gather = {};
+
+namespace detail {
+  inline auto
+  block_size_log2(const blocked_gather_policy& pol) -> int {
+    int log2 = 0;
+    while ((std::ptrdiff_t(1)<<log2) < pol.block_size) ++log2;
+    return log2;
+  }
+
+  /// first position of each block, if each block receives exactly `block_sz` elements
+  template<class I> auto
+  block_offsets(I n_block, I block_sz) -> std::vector<I> {
+    std::vector<I> offsets(n_block);
+    for (I b=0; b<n_block; ++b) {
+      offsets[b] = b*block_sz;
+    }
+    return offsets;
+  }
+  /// first position of each block, if block `b` receives the `block_id(k)==b` elements, k in [0,n)
+  template<class I, class F> auto
+  block_offsets(I n_block, I n, F block_id) -> std::vector<I> {
+    std::vector<I> offsets(n_block,0);
+    for (I k=0; k<n; ++k) {
+      ++offsets[block_id(k)];
+    }
+    std::exclusive_scan(begin(offsets),end(offsets),begin(offsets),I(0));
+    return offsets;
+  }
+
+  /// w[i] = v[idx[i]] for i in [0,n), with idx[i] in [0,m)
+  /// If `idx_is_permutation`, m==n and each source block is known to be read exactly `block_size` times
+  template<class Rand_it0, class Rand_it1, class Rand_it2, class I> auto
+  blocked_gather_n(const blocked_gather_policy& pol, Rand_it0 first, I m, Rand_it1 d_first, Rand_it2 idx_first, I n, bool idx_is_permutation) -> Rand_it1 {
+    using T = typename std::iterator_traits<Rand_it0>::value_type;
+    struct dst_src { I dst; I src; };
+    struct dst_val { T val; I dst; };
+
+    int log2 = block_size_log2(pol);
+    I block_sz = I(1)<<log2;
+    if (n<=block_sz || m<=block_sz) { // everything already fits in a block
+      return std::transform(idx_first, idx_first+n, d_first, [&](I j){ return *(first+j); });
+    }
+
+    // 1. bucket the (destination,source) pairs by source block
+    I n_src_block = (m+block_sz-1)>>log2;
+    std::vector<I> src_pos = idx_is_permutation ?
+        block_offsets(n_src_block,block_sz)
+      : block_offsets(n_src_block,n,[&](I i){ return I(*(idx_first+i))>>log2; });
+    std::unique_ptr<dst_src[]> by_src(new dst_src[n]); // not a vector: no need to zero-initialize
+    for (I i=0; i<n; ++i) {
+      I j = *(idx_first+i);
+      by_src[src_pos[j>>log2]++] = {i,j};
+    }
+
+    // 2. read each source block, bucket the (destination,value) pairs by destination block
+    //    Note: destination block `b` receives exactly the destinations [b*block_sz,(b+1)*block_sz)
+    I n_dst_block = (n+block_sz-1)>>log2;
+    std::vector<I> dst_pos = block_offsets(n_dst_block,block_sz);
+    std::unique_ptr<dst_val[]> by_dst(new dst_val[n]);
+    for (I k=0; k<n; ++k) {
+      auto [i,j] = by_src[k];
+      by_dst[dst_pos[i>>log2]++] = {*(first+j),i};
+    }
+
+    // 3. write each destination block
+    for (I l=0; l<n; ++l) {
+      *(d_first+by_dst[l].dst) = std::move(by_dst[l].val);
+    }
+    return d_first+n;
+  }
+}
+
+template<class Rand_it0, class Output_it, class Rand_it1, class I> auto
+permute_copy_n(direct_gather_policy, Rand_it0 first, Output_it d_first, Rand_it1 perm_first, I n) -> Output_it {
+  return permute_copy_n(first,d_first,perm_first,n);
+}
+template<class Rand_it0, class Rand_it1, class Rand_it2, class I> auto
+// requires Rand_it0,Rand_it1,Rand_it2 are random access iterators
+permute_copy_n(const blocked_gather_policy& pol, Rand_it0 first, Rand_it1 d_first, Rand_it2 perm_first, I n) -> Rand_it1 {
+  // Same as permute_copy_n(first,d_first,perm_first,n), with the same preconditions
+  return detail::blocked_gather_n(pol,first,n,d_first,perm_first,n,true);
+}
+template<class Gather_policy, class T, class I> auto
+permute_copy(const Gather_policy& pol, const std::vector<T>& v, const std::vector<I>& p) -> std::vector<T> {
+  using index_type = typename std::vector<I>::difference_type;
+  index_type n = p.size();
+  std::vector<T> w(n);
+  permute_copy_n(pol,begin(v),begin(w),begin(p),n);
+  return w;
+}
+// blocked gather }
+
+
+template<class array_type> auto
+compose_permutations(direct_gather_policy, const array_type& p0, const array_type& p1) {
+  return compose_permutations(p0,p1);
+}
+template<class array_type> auto
+compose_permutations(const blocked_gather_policy& pol, const array_type& p0, const array_type& p1) {
+  // Same as compose_permutations(p0,p1): res is the gather of p1 through p0
+  using index_type = typename array_type::difference_type;
+  array_type res(p0.size());
+  detail::blocked_gather_n(pol,begin(p1),index_type(p1.size()),begin(res),begin(p0),index_type(p0.size()),false);
+  return res;
+}
+
+
 // REF: https://stackoverflow.com/a/17074810/1583122
 // REF: https://blog.merovius.de/2014/08/12/applying-permutation-in-constant.html
 // ALSO: with range-v3 https://stackoverflow.com/a/53785022/1583122
 // ALSO: (in place?) https://stackoverflow.com/a/44030600/1583122
+// Each cycle is walked once: its first element is moved into a temporary,
+// then each element of the cycle is moved from its source, and the temporary closes the cycle
 template<class Rand_it, class I> auto
 permute(Rand_it it, const std::vector<I>& p) -> void {
-  int sz = p.size();
-  std::vector<bool> done(sz);
+  I sz = p.size();
+  std::vector<std::uint8_t> done(sz,0); // not vector<bool>: byte access is faster
   for (I i = 0; i < sz; ++i){
-    if (done[i]){
+    if (done[i] || p[i]==i){
       continue;
     }
-    done[i] = true;
-    I prev_j = i;
-    I j = p[i];
-    while (i != j){
-      std::swap(*(it+prev_j),*(it+j));
-      done[j] = true;
-      prev_j = j;
+    typename std::iterator_traits<Rand_it>::value_type tmp = std::move(*(it+i));
+    I j = i;
+    while (p[j] != i){
+      *(it+j) = std::move(*(it+p[j]));
+      done[j] = 1;
       j = p[j];
     }
+    *(it+j) = std::move(tmp);
+    done[j] = 1;
   }
 }
 template<class T, class I> auto
@@ -115,14 +357,104 @@ permute(std::vector<T>& vec, const std::vector<I>& p) -> void {
   return permute(vec.begin(),p);
 }
 
-template<class Int_range, class Tuple, size_t... Is> auto
-apply_permutation__impl(const Int_range& perm, Tuple& rngs, std::index_sequence<Is...>) -> void {
-  ( permute(std::get<Is>(rngs),perm) , ... );
+
+// permutation_plan {
+namespace detail {
+  template<class T, class = void>
+  struct element_value { using type = typename std::iterator_traits<T>::value_type; }; // pointers
+  template<class T>
+  struct element_value<T,std::void_t<typename T::value_type>> { using type = typename T::value_type; }; // ranges and iterator classes
+}
+/// value type of a random access iterator or range (not its reference type, which may be a proxy)
+template<class T> using element_value_t = typename detail::element_value<std::decay_t<T>>::type;
+
+/**
+  Cycle decomposition of a permutation, computed once,
+  so that the permutation can then be applied to any number of ranges
+    - without allocation
+    - without re-walking the permutation to find its cycles
+    - with one move per element (plus one per cycle), not one swap
+  Only non-trivial cycles are stored (fixed points are not moved),
+  each cycle being stored in the order it is walked (i.e. cycle_elts[k+1] == p[cycle_elts[k]])
+  Note: same convention as `permute`: after application, x[i] is the old x[p[i]]
+*/
+template<class I>
+class permutation_plan {
+  public:
+  // ctors
+    permutation_plan() = default;
+
+    template<class Int_range> explicit
+    permutation_plan(const Int_range& p)
+      : sz(p.size())
+    {
+      std::vector<std::uint8_t> done(sz,0);
+      for (I i=0; i<sz; ++i) {
+        if (done[i] || p[i]==i) continue;
+        I j = i;
+        do {
+          cycle_elts.push_back(j);
+          done[j] = 1;
+          j = p[j];
+        } while (j!=i);
+        cycle_offsets.push_back(cycle_elts.size());
+      }
+    }
+
+  // accessors
+    auto size() const -> I {
+      return sz;
+    }
+    auto n_cycle() const -> I {
+      return cycle_offsets.size()-1;
+    }
+    /// number of elements that are not fixed points
+    auto n_moved() const -> I {
+      return cycle_elts.size();
+    }
+
+  // application
+    /// Apply the permutation to each of `xs` (random access iterators or ranges), in a single walk over the cycles
+    template<class... Rand_access> auto
+    apply(Rand_access&&... xs) const -> void {
+      I n_cyc = n_cycle();
+      for (I c=0; c<n_cyc; ++c) {
+        const I* cur = cycle_elts.data()+cycle_offsets[c];
+        const I* last = cycle_elts.data()+cycle_offsets[c+1]-1;
+        std::tuple<element_value_t<Rand_access>...> leaders(std::move(xs[*cur])...);
+        for (; cur!=last; ++cur) {
+          ( (xs[cur[0]] = std::move(xs[cur[1]])) , ... );
+        }
+        std::apply([&](auto&... leader){ ( (xs[*last] = std::move(leader)) , ... ); },leaders);
+      }
+    }
+
+  private:
+    I sz = 0;
+    std::vector<I> cycle_elts;
+    std::vector<I> cycle_offsets = {0};
+};
+
+template<class Int_range> permutation_plan(const Int_range&) -> permutation_plan<typename Int_range::value_type>;
+
+template<class Rand_it, class I> auto
+permute(Rand_it it, const permutation_plan<I>& plan) -> void {
+  plan.apply(it);
+}
+template<class T, class I> auto
+permute(std::vector<T>& vec, const permutation_plan<I>& plan) -> void {
+  plan.apply(vec);
+}
+// permutation_plan }
+
+
+template<class I, class Tuple> auto
+apply_permutation(const permutation_plan<I>& plan, Tuple&& rngs) -> void {
+  std::apply([&plan](auto&... rngs){ plan.apply(rngs...); },rngs);
 }
 template<class Int_range, class Tuple> auto
-apply_permutation(const Int_range& perm, Tuple& rngs) -> void {
-  constexpr auto n_range = std::tuple_size_v<Tuple>;
-  apply_permutation__impl(perm,rngs,std::make_index_sequence<n_range>());
+apply_permutation(const Int_range& perm, Tuple&& rngs) -> void {
+  apply_permutation(permutation_plan(perm),rngs);
 }
 
 template<class Tuple, class Comp = std::less<>, class sort_algo_type = decltype(std_sort_lambda)> auto
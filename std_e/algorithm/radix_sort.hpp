@@ -0,0 +1,138 @@
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include "std_e/utils/functional.hpp"
+
+
+namespace std_e {
+
+
+// radix keys {
+/**
+  Keys that can be radix-sorted: 8/16/32/64-bit integers, float and double
+  Each key is mapped to an unsigned integer of the same size whose order is the order of the key:
+    - unsigned integers are kept as is
+    - signed integers have their sign bit flipped
+    - floating point numbers have their sign bit flipped if positive, all their bits flipped if negative
+      (hence -0. is before +0., and NaNs are placed at both ends depending on their sign bit)
+*/
+template<class K> constexpr bool is_radix_sortable =
+     (std::is_integral_v<K> && !std::is_same_v<K,bool> && (sizeof(K)==1 || sizeof(K)==2 || sizeof(K)==4 || sizeof(K)==8))
+  || std::is_same_v<K,float>
+  || std::is_same_v<K,double>;
+
+namespace detail {
+  template<class K, class = void> struct radix_bits_type;
+  template<class K> struct radix_bits_type<K,std::enable_if_t<std::is_integral_v<K>>> { using type = std::make_unsigned_t<K>; };
+  template<> struct radix_bits_type<float > { using type = std::uint32_t; };
+  template<> struct radix_bits_type<double> { using type = std::uint64_t; };
+}
+template<class K> using radix_bits_t = typename detail::radix_bits_type<K>::type;
+
+template<class K> auto
+radix_bits(K x) -> radix_bits_t<K> {
+  using U = radix_bits_t<K>;
+  constexpr U sign_bit = U(1) << (8*sizeof(U)-1);
+  if constexpr (std::is_unsigned_v<K>) {
+    return x;
+  } else if constexpr (std::is_integral_v<K>) {
+    return U(x) ^ sign_bit;
+  } else {
+    U u;
+    std::memcpy(&u,&x,sizeof(U));
+    return (u & sign_bit) ? ~u : (u | sign_bit);
+  }
+}
+// radix keys }
+
+
+/**
+  Stable LSD radix sort of [first,last) by `proj(*it)`, in increasing order
+    - `proj(*it)` must be radix-sortable (see `is_radix_sortable`)
+    - one pass per byte of the key, bytes that are the same for all the keys are skipped
+    - `proj` is called (#passes+1) times per element, so it should be cheap (e.g. access to a member)
+  Complexity: O(n * sizeof(key)) moves
+  Requires one buffer of `n` elements
+*/
+template<class Rand_it, class Proj = identity_closure> auto
+// requires Rand_it is a random access iterator
+radix_sort(Rand_it first, Rand_it last, Proj proj = identity) -> void {
+  using I = typename std::iterator_traits<Rand_it>::difference_type;
+  using T = typename std::iterator_traits<Rand_it>::value_type;
+  using K = std::decay_t<std::invoke_result_t<const Proj&,const T&>>;
+  static_assert(is_radix_sortable<K>,"radix_sort: the key must be an integer or a floating point number");
+  using U = radix_bits_t<K>;
+  constexpr int n_pass = sizeof(U);
+  constexpr int n_bucket = 256;
+
+  I n = last-first;
+  if (n<2) return;
+
+  // 1. histograms of all the passes, in one read
+  std::vector<std::array<I,n_bucket>> counts(n_pass);
+  for (auto& count : counts) count.fill(0);
+  for (auto it=first; it!=last; ++it) {
+    U u = radix_bits(proj(*it));
+    for (int p=0; p<n_pass; ++p) {
+      ++counts[p][(u>>(8*p)) & 0xff];
+    }
+  }
+
+  // 2. one stable scatter per pass, alternating between the range and a buffer
+  std::vector<T> buf(n);
+  bool in_buf = false;
+  for (int p=0; p<n_pass; ++p) {
+    auto& count = counts[p];
+    if (std::find(begin(count),end(count),n) != end(count)) continue; // all keys have the same byte
+
+    std::array<I,n_bucket> pos;
+    std::exclusive_scan(begin(count),end(count),begin(pos),I(0));
+    auto scatter = [&pos,&proj,p](auto src_first, auto src_last, auto dst){
+      for (auto it=src_first; it!=src_last; ++it) {
+        U u = radix_bits(proj(*it));
+        *(dst + pos[(u>>(8*p)) & 0xff]++) = std::move(*it);
+      }
+    };
+    if (in_buf) scatter(begin(buf),end(buf),first);
+    else        scatter(first,last,begin(buf));
+    in_buf = !in_buf;
+  }
+  if (in_buf) {
+    std::move(begin(buf),end(buf),first);
+  }
+}
+
+
+/**
+  Radix sort usable as the `sort_algo` parameter of sort_permutation, zip_sort, multi_range::sort_by...
+  e.g. `sort_permutation(x,std::less<>{},radix_sort_algo)`
+    - the sort_permutation functions recognize it and radix-sort (key,index) pairs
+      if the key is radix-sortable and `comp` is std::less or std::greater
+    - otherwise (or if called directly with an arbitrary comparator), it falls back to std::stable_sort
+  Note: for floating point keys, the order is a total order (see `radix_bits`),
+        which differs from std::less for -0. and NaNs
+*/
+struct radix_sort_algo_type {
+  template<class Rand_it, class Comp> auto
+  operator()(Rand_it first, Rand_it last, Comp comp) const -> void {
+    using T = typename std::iterator_traits<Rand_it>::value_type;
+    if constexpr (is_radix_sortable<T> && (std::is_same_v<Comp,std::less<>> || std::is_same_v<Comp,std::less<T>>)) {
+      radix_sort(first,last);
+    } else {
+      std::stable_sort(first,last,comp);
+    }
+  }
+};
+inline constexpr radix_sort_algo_type radix_sort_algo = {};
+
+
+} // std_e
@@ -0,0 +1,181 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#if defined(__SSE2__)
+  #include <immintrin.h>
+#endif
+
+
+namespace std_e {
+
+
+/**
+  In-register prefix sums of 32 and 64-bit integers
+  Used by std_e::inclusive_scan, std_e::exclusive_scan and std_e::partial_accumulate
+  when the operation is std::plus and the ranges are contiguous (see `use_simd_scan`)
+  A vector of W integers is scanned with log2(W) shift-and-add steps,
+  then the carry of the previous vector is added:
+  contrary to the scalar loop, there is only one addition per vector on the dependency chain
+  The instruction set is chosen at compile time: AVX2 if enabled, else SSE2
+  (AVX-512 targets use the AVX2 version)
+*/
+namespace detail {
+  constexpr auto
+  is_constant_evaluated() -> bool {
+    #if defined(__cpp_lib_is_constant_evaluated)
+      return std::is_constant_evaluated();
+    #else
+      return __builtin_is_constant_evaluated();
+    #endif
+  }
+
+  template<class It, class T = typename std::iterator_traits<It>::value_type> constexpr bool is_contiguous_iterator =
+       std::is_pointer_v<It>
+    || std::is_same_v<It,typename std::vector<T>::iterator>
+    || std::is_same_v<It,typename std::vector<T>::const_iterator>;
+
+  template<class T> constexpr bool is_simd_scan_type =
+       std::is_integral_v<T> && !std::is_same_v<T,bool> && (sizeof(T)==4 || sizeof(T)==8);
+
+  template<class Op, class T> constexpr bool is_plus =
+       std::is_same_v<Op,std::plus<>> || std::is_same_v<Op,std::plus<T>>;
+
+  template<class It> using iter_value_t = std::remove_cv_t<typename std::iterator_traits<It>::value_type>;
+
+  template<class Input_it, class Output_it, class T, class Op> constexpr auto
+  use_simd_scan() -> bool {
+    #if defined(__SSE2__)
+      if constexpr (is_simd_scan_type<T> && is_plus<Op,T> && std::is_same_v<iter_value_t<Input_it>,T> && std::is_same_v<iter_value_t<Output_it>,T>) {
+        return is_contiguous_iterator<Input_it> && is_contiguous_iterator<Output_it>;
+      } else {
+        return false;
+      }
+    #else
+      return false;
+    #endif
+  }
+}
+
+/// Ranges [first,last) -> [d_first,...) of type T, accumulated with `op`, starting from an initial value of type T
+template<class Input_it, class Output_it, class T, class Op> constexpr bool use_simd_scan = detail::use_simd_scan<Input_it,Output_it,T,Op>();
+
+
+#if defined(__SSE2__)
+namespace detail {
+  #if defined(__AVX2__)
+    using simd_int = __m256i;
+    inline auto simd_load (const void* p) -> simd_int { return _mm256_loadu_si256((const simd_int*)p); }
+    inline auto simd_store(void* p, simd_int x) -> void { _mm256_storeu_si256((simd_int*)p,x); }
+    inline auto simd_set1(std::int32_t x) -> simd_int { return _mm256_set1_epi32(x); }
+    inline auto simd_set1(std::int64_t x) -> simd_int { return _mm256_set1_epi64x(x); }
+    inline auto simd_add(simd_int x, simd_int y, std::int32_t) -> simd_int { return _mm256_add_epi32(x,y); }
+    inline auto simd_add(simd_int x, simd_int y, std::int64_t) -> simd_int { return _mm256_add_epi64(x,y); }
+    inline auto simd_sub(simd_int x, simd_int y, std::int32_t) -> simd_int { return _mm256_sub_epi32(x,y); }
+    inline auto simd_sub(simd_int x, simd_int y, std::int64_t) -> simd_int { return _mm256_sub_epi64(x,y); }
+
+    inline auto
+    simd_prefix_sum(simd_int x, std::int32_t) -> simd_int {
+      x = _mm256_add_epi32(x,_mm256_slli_si256(x,4)); // scan of each 128-bit half
+      x = _mm256_add_epi32(x,_mm256_slli_si256(x,8));
+      simd_int lo_in_hi = _mm256_permute2x128_si256(x,x,0x08); // [0, lower half]
+      return _mm256_add_epi32(x,_mm256_shuffle_epi32(lo_in_hi,0xff)); // add the last of the lower half to the upper half
+    }
+    inline auto
+    simd_prefix_sum(simd_int x, std::int64_t) -> simd_int {
+      x = _mm256_add_epi64(x,_mm256_slli_si256(x,8));
+      simd_int lo_in_hi = _mm256_permute2x128_si256(x,x,0x08);
+      return _mm256_add_epi64(x,_mm256_shuffle_epi32(lo_in_hi,0xee));
+    }
+    inline auto simd_broadcast_last(simd_int x, std::int32_t) -> simd_int { return _mm256_permutevar8x32_epi32(x,_mm256_set1_epi32(7)); }
+    inline auto simd_broadcast_last(simd_int x, std::int64_t) -> simd_int { return _mm256_permute4x64_epi64(x,0xff); }
+  #else
+    using simd_int = __m128i;
+    inline auto simd_load (const void* p) -> simd_int { return _mm_loadu_si128((const simd_int*)p); }
+    inline auto simd_store(void* p, simd_int x) -> void { _mm_storeu_si128((simd_int*)p,x); }
+    inline auto simd_set1(std::int32_t x) -> simd_int { return _mm_set1_epi32(x); }
+    inline auto simd_set1(std::int64_t x) -> simd_int { return _mm_set1_epi64x(x); }
+    inline auto simd_add(simd_int x, simd_int y, std::int32_t) -> simd_int { return _mm_add_epi32(x,y); }
+    inline auto simd_add(simd_int x, simd_int y, std::int64_t) -> simd_int { return _mm_add_epi64(x,y); }
+    inline auto simd_sub(simd_int x, simd_int y, std::int32_t) -> simd_int { return _mm_sub_epi32(x,y); }
+    inline auto simd_sub(simd_int x, simd_int y, std::int64_t) -> simd_int { return _mm_sub_epi64(x,y); }
+
+    inline auto
+    simd_prefix_sum(simd_int x, std::int32_t) -> simd_int {
+      x = _mm_add_epi32(x,_mm_slli_si128(x,4));
+      return _mm_add_epi32(x,_mm_slli_si128(x,8));
+    }
+    inline auto
+    simd_prefix_sum(simd_int x, std::int64_t) -> simd_int {
+      return _mm_add_epi64(x,_mm_slli_si128(x,8));
+    }
+    inline auto simd_broadcast_last(simd_int x, std::int32_t) -> simd_int { return _mm_shuffle_epi32(x,0xff); }
+    inline auto simd_broadcast_last(simd_int x, std::int64_t) -> simd_int { return _mm_shuffle_epi32(x,0xee); }
+  #endif
+
+  template<bool inclusive, class T> auto
+  simd_scan_contiguous(const T* first, std::ptrdiff_t n, T* d_first, T init) -> T {
+    using S = std::conditional_t<sizeof(T)==4,std::int32_t,std::int64_t>; // unsigned: same instructions
+    constexpr std::ptrdiff_t W = sizeof(simd_int)/sizeof(T);
+
+    std::ptrdiff_t i = 0;
+    simd_int carry = simd_set1(S(init));
+    for (; i+W<=n; i+=W) {
+      simd_int x = simd_load(first+i);
+      simd_int incl = simd_add(simd_prefix_sum(x,S()),carry,S());
+      if constexpr (inclusive) {
+        simd_store(d_first+i,incl);
+      } else {
+        simd_store(d_first+i,simd_sub(incl,x,S()));
+      }
+      carry = simd_broadcast_last(incl,S());
+    }
+
+    T acc;
+    std::memcpy(&acc,&carry,sizeof(T));
+    for (; i<n; ++i) {
+      T x = first[i];
+      if constexpr (!inclusive) d_first[i] = acc;
+      acc += x;
+      if constexpr (inclusive) d_first[i] = acc;
+    }
+    return acc;
+  }
+}
+#else
+namespace detail {
+  // scalar fallback, so that simd_scan is declared on every target (it is not used, since use_simd_scan is false)
+  template<bool inclusive, class T> auto
+  simd_scan_contiguous(const T* first, std::ptrdiff_t n, T* d_first, T init) -> T {
+    T acc = init;
+    for (std::ptrdiff_t i=0; i<n; ++i) {
+      T x = first[i];
+      if constexpr (!inclusive) d_first[i] = acc;
+      acc += x;
+      if constexpr (inclusive) d_first[i] = acc;
+    }
+    return acc;
+  }
+}
+#endif
+
+/// If `inclusive`, d_first[i] = init + first[0] + ... + first[i]
+/// else            d_first[i] = init + first[0] + ... + first[i-1]
+/// Returns the sum of `init` and of all the elements
+/// Requires `use_simd_scan<Input_it,Output_it,T,std::plus<>>`
+/// Note: [first,last) and [d_first,...) may be the same range
+template<bool inclusive, class Input_it, class Output_it, class T> auto
+simd_scan(Input_it first, Input_it last, Output_it d_first, T init) -> T {
+  static_assert(detail::is_simd_scan_type<T>);
+  if (first==last) return init;
+  return detail::simd_scan_contiguous<inclusive>(&*first,last-first,&*d_first,init);
+}
+
+
+} // std_e
@@ -2,16 +2,34 @@
 
 
 #include <utility>
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include "std_e/utils/switch.hpp"
+#include "std_e/data_structure/strided_span.hpp"
+#include "std_e/base/macros.hpp"
 
 
 namespace std_e {
 
 
 // DOC REF https://en.wikipedia.org/wiki/Sorting_network
+/// Branchless for arithmetic types: a branch would be mispredicted half of the time
+///   Both outputs are selected from a single comparison between local copies, which compiles to conditional moves
+///   (GCC keeps a branch for std::min/max on references to integers)
+///   Note: for floating point, std::min/max would not give a permutation of the input with NaN or signed zeros
 template<class T> auto
 sort_network(T& x0, T& x1) -> void {
-  if (x1<x0) {
-    std::swap(x0,x1);
+  if constexpr (std::is_arithmetic_v<T>) {
+    T a = x0;
+    T b = x1;
+    bool swap = b<a;
+    x0 = swap ? b : a;
+    x1 = swap ? a : b;
+  } else {
+    if (x1<x0) {
+      std::swap(x0,x1);
+    }
   }
 }
 template<class T> auto
@@ -33,8 +51,75 @@ sort_network(T& x0, T& x1, T& x2, T& x3) -> void {
 
 
 
+// generated networks {
+/**
+  Sorting networks of any size, generated at compile time
+  The network is Batcher's odd-even merge sort (for sizes that are not powers of two,
+  the comparators involving elements past N are dropped, which does not change the result).
+  Its number of comparators is optimal up to N=8, and close to the best known networks up to N=32:
+    N            |  8 | 16 | 32
+    Batcher      | 19 | 63 | 191
+    best known   | 19 | 60 | 185
+  REF: Knuth, The Art of Computer Programming, vol. 3, §5.3.4
+*/
+struct comparator {
+  int i;
+  int j;
+};
+
+namespace detail {
+  // DOC REF https://en.wikipedia.org/wiki/Batcher_odd%E2%80%93even_mergesort
+  template<class F> constexpr auto
+  for_each_odd_even_merge_comparator(int n, F f) -> void {
+    for (int p=1; p<n; p*=2) {
+      for (int k=p; k>=1; k/=2) {
+        for (int j=k%p; j<=n-1-k; j+=2*k) {
+          for (int i=0; i<=std::min(k-1,n-j-k-1); ++i) {
+            if ((i+j)/(2*p) == (i+j+k)/(2*p)) {
+              f(i+j,i+j+k);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  constexpr auto
+  n_comparator(int n) -> int {
+    int cnt = 0;
+    for_each_odd_even_merge_comparator(n,[&cnt](int,int){ ++cnt; });
+    return cnt;
+  }
+
+  template<int N> constexpr auto
+  generate_sorting_network() {
+    std::array<comparator,n_comparator(N)> net = {};
+    int k = 0;
+    for_each_odd_even_merge_comparator(N,[&net,&k](int i, int j){ net[k++] = {i,j}; });
+    return net;
+  }
+}
+
+template<int N> constexpr auto sorting_network_comparators = detail::generate_sorting_network<N>();
+
 template<int N>
-struct sorting_network;
+struct sorting_network {
+  template<class Random_it> static auto
+  sort(Random_it first) -> void {
+    apply_comparators(first,std::make_index_sequence<sorting_network_comparators<N>.size()>{});
+  }
+  private:
+    // unrolled at compile time: one sort_network(x0,x1) per comparator
+    template<class Random_it, size_t... Is> static auto
+    apply_comparators(Random_it first, std::index_sequence<Is...>) -> void {
+      constexpr auto& net = sorting_network_comparators<N>;
+      ( sort_network(first[net[Is].i],first[net[Is].j]) , ... );
+    }
+};
+// generated networks }
+
+
+// hand-written optimal networks {
 
 template<>
 struct sorting_network<0> {
@@ -71,6 +156,87 @@ struct sorting_network<4> {
     sort_network(first[0],first[1],first[2],first[3]);
   }
 };
+// hand-written optimal networks }
+
+
+// sort_small {
+constexpr int max_sorting_network_size = 32;
+
+/// Sorts [first,last) with the sorting network of size `last-first`, chosen at run time
+/// Falls back to std::sort for sizes above `max_sorting_network_size`
+template<class Random_it> auto
+sort_small(Random_it first, Random_it last) -> void {
+  int n = last-first;
+  if (n>max_sorting_network_size) {
+    return std::sort(first,last);
+  }
+  using sizes = std::make_integer_sequence<int,max_sorting_network_size+1>;
+  auto sort_with_network = [](auto n_c, Random_it first){ sorting_network<decltype(n_c)::value>::sort(first); };
+  switch_<sizes>(n).apply(sort_with_network,first);
+}
+// sort_small }
+
+
+// batched networks {
+/**
+  Sorts many small independent rows of K elements with the same network
+    - row `r` is [first+r*stride, first+r*stride+K)
+    - rows are processed by batches of `sort_rows_batch_size`, transposed so that each row is a lane:
+        lanes[k][b] is the k-th element of the b-th row of the batch
+      then the network is applied to all the lanes at once: the loop over the lanes is vectorized
+      by the compiler (one comparator = one SIMD min and one SIMD max)
+    - the remaining rows are sorted one by one
+  Only for arithmetic types, whose min/max are branchless
+  Note: the speedup depends on the target instruction set
+        (e.g. SSE2 has no packed min/max for 32-bit integers, SSE4.1 and AVX2 do)
+*/
+template<class T> constexpr int sort_rows_batch_size = 64/sizeof(T); // a cache line of each of the K elements
+
+namespace detail {
+  template<int K, int B, class T, size_t... Is> FORCE_INLINE auto
+  apply_comparators_to_lanes(T (&lanes)[K][B], std::index_sequence<Is...>) -> void {
+    constexpr auto& net = sorting_network_comparators<K>;
+    // the whole network is applied to lane `b`: the loop over `b` is vectorized
+    for (int b=0; b<B; ++b) {
+      ( sort_network(lanes[net[Is].i][b],lanes[net[Is].j][b]) , ... );
+    }
+  }
+}
+
+template<int K, class T, class I> auto
+sort_rows(T* first, I n_row, I stride) -> void {
+  static_assert(std::is_arithmetic_v<T>,"sort_rows: only arithmetic types are supported");
+  constexpr int B = sort_rows_batch_size<T>;
+  constexpr auto n_comp = sorting_network_comparators<K>.size();
+
+  I r = 0;
+  alignas(64) T lanes[K][B];
+  for (; r+B<=n_row; r+=B) {
+    T* batch = first + r*stride;
+    for (int b=0; b<B; ++b) {
+      for (int k=0; k<K; ++k) {
+        lanes[k][b] = batch[b*stride+k];
+      }
+    }
+    detail::apply_comparators_to_lanes<K,B>(lanes,std::make_index_sequence<n_comp>{});
+    for (int b=0; b<B; ++b) {
+      for (int k=0; k<K; ++k) {
+        batch[b*stride+k] = lanes[k][b];
+      }
+    }
+  }
+  for (T* row = first + r*stride; r<n_row; ++r, row+=stride) {
+    sorting_network<K>::sort(row);
+  }
+}
+
+/// Each element of `rows` is the first of a row of K elements (hence `rows.stride_length()>=K`)
+/// Note: a multi_array of shape (K,n) is viewed as such by `make_strided_span<K>(x)`
+template<int K, class T, class I, int N> auto
+sort_rows(strided_span<T,I,N> rows) -> void {
+  sort_rows<K>(rows.data(),std::ptrdiff_t(rows.size()),std::ptrdiff_t(rows.stride_length()));
+}
+// batched networks }
 
 
 } // std_e
@@ -51,6 +51,27 @@ TEST_CASE("accumulate_while_adjacent") {
 }
 
 
+TEST_CASE("branchless_lower_bound_position") {
+  // with duplicates, and bigger than one cache line to exercise both the halving and the linear search
+  vector<int> v;
+  for (int i=0; i<200; ++i) {
+    v.push_back(2*(i/3));
+  }
+  for (int x=-1; x<=v.back()+1; ++x) {
+    CHECK( branchless_lower_bound_position(v.data(),v.size(),x) == lower_bound_position(v,x) );
+  }
+
+  SUBCASE("small and empty ranges") {
+    vector<double> w = {1.,2.5,4.};
+    CHECK( branchless_lower_bound_position(w.data(),0,2.) == 0 );
+    CHECK( branchless_lower_bound_position(w.data(),3,0.) == 0 );
+    CHECK( branchless_lower_bound_position(w.data(),3,2.5) == 1 );
+    CHECK( branchless_lower_bound_position(w.data(),3,3.) == 2 );
+    CHECK( branchless_lower_bound_position(w.data(),3,5.) == 3 );
+  }
+}
+
+
 TEST_CASE("offset") {
   vector<int>          v = { 10, 100, 1000 };
   vector<int> expected_v = { 12, 102, 1002 };
@@ -0,0 +1,96 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/algorithm/parallel_fill_copy.hpp"
+#include "std_e/multi_array/multi_array.hpp"
+#include "std_e/multi_array/multi_array/contiguous_runs.hpp"
+#include "std_e/buffer/buffer_vector.hpp"
+#include <numeric>
+#include <vector>
+
+using namespace std_e;
+
+
+TEST_CASE("fill and copy with policies") {
+  parallel_policy pol = {3,10};
+
+  SUBCASE("small ranges") {
+    std::vector<int> v(100);
+    fill(pol,begin(v),end(v),7);
+    CHECK( v == std::vector<int>(100,7) );
+
+    std::iota(begin(v),end(v),0);
+    std::vector<int> w(100);
+    copy(pol,begin(v),end(v),begin(w));
+    CHECK( w == v );
+
+    std::vector<int> x(100);
+    copy(seq,v.data(),v.data()+100,x.data());
+    CHECK( x == v );
+  }
+  SUBCASE("non-temporal, unaligned") {
+    std::ptrdiff_t n = non_temporal_threshold/sizeof(std::int16_t) + 13;
+    std::vector<std::int16_t> v(n+1);
+    std::int16_t* first = v.data()+1; // not aligned on 16 bytes
+    fill(pol,first,first+n,std::int16_t(3));
+    CHECK( v[0] == 0 );
+    CHECK( std::all_of(first,first+n,[](auto x){ return x==3; }) );
+
+    std::iota(begin(v),end(v),std::int16_t(0));
+    std::vector<std::int16_t> w(n+3);
+    copy(seq,v.data(),v.data()+n,w.data()+3);
+    CHECK( std::equal(v.data(),v.data()+n,w.data()+3) );
+    CHECK( w[2] == 0 );
+  }
+  SUBCASE("contiguous ranges") {
+    auto v = make_buffer_vector<double>(size_t(1000));
+    fill(pol,v,2.5);
+    CHECK( std::all_of(begin(v),end(v),[](double x){ return x==2.5; }) );
+
+    uninitialized_multi_array<double,2> x(17,5);
+    fill(pol,x,1.);
+    CHECK( std::all_of(begin(x),end(x),[](double x){ return x==1.; }) );
+
+    padded_multi_array<double,2> y(5,3);
+    padded_multi_array<double,2> z(5,3);
+    fill(pol,y,4.);
+    copy(pol,y,z);
+    CHECK( z(4,2) == 4. );
+    CHECK( z.data()[z.memory_size()-1] == 4. ); // the padding is also written
+  }
+}
+
+TEST_CASE("fill and copy with policies: views are not contiguous ranges") {
+  dyn_multi_array<int,2> x(4,4);
+  std::fill(begin(x),end(x),0);
+  auto b = make_block_view(x,multi_index<int,2>{2,2},multi_index<int,2>{2,2});
+  auto row_1 = make_strided_array(x,0,1);
+
+  // their data() is the one of `x`: fill(pol,view,value) would write the first elements of `x`
+  static_assert(!is_contiguous_range<decltype(b)>);
+  static_assert(!is_contiguous_range<decltype(row_1)>);
+  static_assert( is_contiguous_range<decltype(x)>);
+  static_assert( is_contiguous_range<std::vector<int>>);
+
+  fill(b,7); // contiguous_runs.hpp
+  fill(seq,x.data(),x.data()+4,1);
+  CHECK( x(0,0) == 1 ); CHECK( x(3,0) == 1 );
+  CHECK( x(1,1) == 0 );
+  CHECK( x(2,2) == 7 ); CHECK( x(3,2) == 7 ); CHECK( x(2,3) == 7 ); CHECK( x(3,3) == 7 );
+  CHECK( x(1,2) == 0 ); CHECK( x(2,1) == 0 );
+
+  SUBCASE("strided layout") {
+    // 2x2 view of the 4x4 buffer: elements 1,2,9,10
+    std::vector<int> buf(16,0);
+    dyn_shape<int,2,strided_layout> sh({2,2},{1,0},{1,8});
+    strided_multi_array_view<int,2> v(make_span(buf.data(),buf.size()),sh);
+    // its memory_size() is the span from the first to the last element, gaps included
+    static_assert(!is_contiguous_range<decltype(v)>);
+
+    fill(v,7); // contiguous_runs.hpp
+    CHECK( buf == std::vector<int>{0,7,7,0, 0,0,0,0, 0,7,7,0, 0,0,0,0} );
+    CHECK( v(1,1) == 7 );
+
+    dyn_multi_array<int,2> y(2,2);
+    copy(v,y); // contiguous_runs.hpp
+    CHECK( y == dyn_multi_array<int,2>{{7,7},{7,7}} );
+  }
+}
@@ -0,0 +1,23 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/algorithm/parallel_partition.hpp"
+#include <vector>
+
+using namespace std;
+
+
+TEST_CASE("parallel_partition") {
+  vector<int> v = {5,12,0,3,17,8,1,9,14,2,11,6,13,4,7,10,16,15};
+  auto is_small = [](int x){ return x<8; };
+
+  std_e::parallel_policy pol = {4,2};
+  auto pp = std_e::parallel_partition(pol,begin(v),end(v),is_small);
+
+  CHECK( pp-begin(v) == 8 );
+  CHECK( all_of(begin(v),pp,is_small) );
+  CHECK( none_of(pp,end(v),is_small) );
+
+  sort(begin(v),end(v));
+  vector<int> expected(18);
+  iota(begin(expected),end(expected),0);
+  CHECK( v == expected );
+}
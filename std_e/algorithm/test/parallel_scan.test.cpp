@@ -0,0 +1,47 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/algorithm/parallel_scan.hpp"
+#include "std_e/interval/interval_sequence.hpp"
+#include <vector>
+#include <string>
+
+using namespace std;
+
+
+TEST_CASE("parallel scans") {
+  std_e::parallel_policy pol = {3,2};
+  vector<int> data = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+
+  SUBCASE("inclusive") {
+    vector<int> res(data.size());
+    std_e::inclusive_scan(pol, begin(data), end(data), begin(res));
+    CHECK( res == vector{3,4,8,9,14,23,25,31,36,39,44} );
+
+    std_e::inclusive_scan(pol, begin(data), end(data), begin(res), std::plus<>(), 100);
+    CHECK( res == vector{103,104,108,109,114,123,125,131,136,139,144} );
+  }
+  SUBCASE("exclusive") {
+    vector<int> res(data.size());
+    std_e::exclusive_scan(pol, begin(data), end(data), begin(res), 0);
+    CHECK( res == vector{0,3,4,8,9,14,23,25,31,36,39} );
+  }
+  SUBCASE("in place") {
+    std_e::exclusive_scan(pol, begin(data), end(data), begin(data), 0);
+    CHECK( data == vector{0,3,4,8,9,14,23,25,31,36,39} );
+  }
+  SUBCASE("partial_accumulate") {
+    vector<int> res(data.size()+1);
+    std_e::partial_accumulate(pol, begin(data), end(data), begin(res), 7);
+    CHECK( res == vector{7,10,11,15,16,21,30,32,38,43,46,51} );
+  }
+  SUBCASE("non-commutative operation") {
+    vector<string> strs = {"a","b","c","d","e","f","g"};
+    vector<string> res(strs.size());
+    std_e::inclusive_scan(pol, begin(strs), end(strs), begin(res), std::plus<>());
+    CHECK( res == vector<string>{"a","ab","abc","abcd","abcde","abcdef","abcdefg"} );
+  }
+  SUBCASE("indices_from_strides") {
+    vector<int> strides = {2,0,3,1,1,4};
+    CHECK( std_e::indices_from_strides(pol,strides) == std_e::interval_vector<int>{0,2,2,5,6,7,11} );
+    CHECK( std_e::indices_from_strides(pol,strides) == std_e::indices_from_strides(strides) );
+  }
+}
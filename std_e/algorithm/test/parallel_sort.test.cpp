@@ -0,0 +1,36 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/algorithm/parallel_sort.hpp"
+#include <vector>
+
+using namespace std;
+
+
+TEST_CASE("parallel_stable_sort") {
+  vector<int> v = {5,12,0,3,17,8,1,9,14,2,11,6,13,4,7,10,16,15,3,8,0};
+
+  SUBCASE("sort") {
+    vector<int> expected = v;
+    sort(begin(expected),end(expected));
+
+    for (int n_thread : {1,2,3,4,7}) {
+      vector<int> w = v;
+      std_e::parallel_policy pol = {n_thread,2};
+      std_e::parallel_stable_sort(pol,begin(w),end(w));
+      CHECK( w == expected );
+    }
+  }
+
+  SUBCASE("stability") {
+    // sort by tens only: elements with the same tens keep their order
+    auto by_tens = [](int i, int j){ return i/10 < j/10; };
+    vector<int> expected = v;
+    stable_sort(begin(expected),end(expected),by_tens);
+
+    for (int n_thread : {2,3,5}) {
+      vector<int> w = v;
+      std_e::parallel_policy pol = {n_thread,2};
+      std_e::parallel_stable_sort(pol,begin(w),end(w),by_tens);
+      CHECK( w == expected );
+    }
+  }
+}
@@ -36,6 +36,37 @@ TEST_CASE("partition_sort") {
     CHECK(                 v == vector{-3, 8,2,6,0,  50,   110,   999,800,200,     10001} );
     CHECK( partition_indices == vector{ 0, 1      ,  5 ,   6  ,   7          ,     10   } );
   }
+  SUBCASE("bucket engine") {
+    vector<int> partition_indices(partition_values.size());
+    std_e::bucket_partition_sort_indices(begin(v),end(v),begin(partition_values),end(partition_values),begin(partition_indices));
+    //                                    0        10   100    120            1000
+    CHECK(                 v == vector{-3, 2,6,8,0,  50,   110,   200,800,999,     10001} ); // stable inside each partition
+    CHECK( partition_indices == vector{    1      ,  5 ,   6  ,   7          ,     10   } );
+  }
+  SUBCASE("parallel") {
+    std_e::parallel_policy pol = {4,2}; // small grain to force the parallel code path
+    auto partition_indices = std_e::partition_sort_indices(pol,v,partition_values);
+    CHECK( partition_indices == vector{0,1,5,6,7,10} );
+    for (int i=0; i<5; ++i) {
+      CHECK( all_of(begin(v)+partition_indices[i],begin(v)+partition_indices[i+1],[&](int x){ return x<partition_values[i]; }) );
+    }
+    CHECK( all_of(begin(v)+partition_indices[5],end(v),[&](int x){ return x>=partition_values[4]; }) );
+  }
+  SUBCASE("parallel, all elements on one side") {
+    std_e::parallel_policy pol = {2,2};
+    vector<int> w = {5,3,4,1,2,0};
+    auto partition_indices = std_e::partition_sort_indices(pol,w,vector{-2,-1,10});
+    CHECK( partition_indices == vector{0,0,0,6} );
+  }
+}
+
+TEST_CASE("partition_sort thread budget") {
+  // the two sides of a split use exactly the budget of the parent
+  CHECK( std_e::detail::n_thread_of_left_side(2,  0,100) == 1 ); // not 0, else 1+2 threads
+  CHECK( std_e::detail::n_thread_of_left_side(2,100,100) == 1 );
+  CHECK( std_e::detail::n_thread_of_left_side(4,  1,100) == 1 );
+  CHECK( std_e::detail::n_thread_of_left_side(4, 50,100) == 2 );
+  CHECK( std_e::detail::n_thread_of_left_side(4, 99,100) == 3 );
 }
 
 TEST_CASE("sort_into_partitions") {
@@ -47,3 +78,155 @@ TEST_CASE("sort_into_partitions") {
   CHECK( jv.flat_view() == expected_values );
   CHECK( jv.indices() == expected_partition_indices );
 }
+
+namespace {
+  // reference: stable sort by key, then partition indices where the key changes
+  template<class T, class F> auto
+  expected_partitions(vector<T> v, F proj) -> std::pair<vector<T>,vector<int>> {
+    std::stable_sort(begin(v),end(v),[&](const T& x, const T& y){ return proj(x)<proj(y); });
+    vector<int> indices = {0};
+    for (int i=1; i<(int)v.size(); ++i) {
+      if (proj(v[i-1])!=proj(v[i])) indices.push_back(i);
+    }
+    if (v.size()>0) indices.push_back(v.size());
+    return {v,indices};
+  }
+  template<class T> auto
+  indices_of(const std_e::jagged_vector<T>& jv) -> vector<int> {
+    return vector<int>(begin(jv.indices()),end(jv.indices()));
+  }
+
+  enum class elt_type { tri=3, quad=4, hexa=8 };
+
+  struct no_default_ctor {
+    explicit no_default_ctor(int i) : i(i) {}
+    int i;
+  };
+  auto operator==(no_default_ctor x, no_default_ctor y) -> bool { return x.i==y.i; }
+}
+
+TEST_CASE("sort_into_partitions key types") {
+  vector<id_string> v;
+  for (int i=0; i<1000; ++i) {
+    v.push_back({(i*37)%23-11,std::to_string(i)}); // negative and positive keys
+  }
+
+  SUBCASE("small integers") {
+    auto proj = [](const id_string& x){ return x.id; };
+    auto [expected_values,expected_indices] = expected_partitions(v,proj);
+    auto jv = std_e::sort_into_partitions(std::move(v),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+  }
+  SUBCASE("spread integers") { // range too big for counting sort
+    auto proj = [](const id_string& x){ return std::int64_t(x.id)<<40; };
+    auto [expected_values,expected_indices] = expected_partitions(v,proj);
+    auto jv = std_e::sort_into_partitions(std::move(v),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+  }
+  SUBCASE("unsigned integers of the whole range") {
+    auto proj = [](const id_string& x){ return x.id<0 ? std::uint64_t(-1) : std::uint64_t(x.id); };
+    auto [expected_values,expected_indices] = expected_partitions(v,proj);
+    auto jv = std_e::sort_into_partitions(std::move(v),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+  }
+  SUBCASE("enums") {
+    auto proj = [](const id_string& x){ return x.id<0 ? elt_type::hexa : (x.id<5 ? elt_type::tri : elt_type::quad); };
+    auto [expected_values,expected_indices] = expected_partitions(v,proj);
+    auto jv = std_e::sort_into_partitions(std::move(v),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+    CHECK( jv.size() == 3 );
+  }
+  SUBCASE("bool") {
+    auto proj = [](const id_string& x){ return x.id%2==0; };
+    auto [expected_values,expected_indices] = expected_partitions(v,proj);
+    auto jv = std_e::sort_into_partitions(std::move(v),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+  }
+  SUBCASE("strings") {
+    auto proj = [](const id_string& x){ return x.s.substr(0,1); };
+    auto [expected_values,expected_indices] = expected_partitions(v,proj);
+    auto jv = std_e::sort_into_partitions(std::move(v),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+  }
+  SUBCASE("small trivially copyable elements: scattered in a new vector") {
+    vector<int> w;
+    for (int i=0; i<1000; ++i) {
+      w.push_back((i*7919)%1001);
+    }
+    auto proj = [](int x){ return x%13-6; };
+    auto [expected_values,expected_indices] = expected_partitions(w,proj);
+    auto jv = std_e::sort_into_partitions(std::move(w),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+
+    vector<int> w_par = expected_values;
+    std::reverse(begin(w_par),end(w_par));
+    auto [expected_values_par,expected_indices_par] = expected_partitions(w_par,proj);
+    auto jv_par = std_e::sort_into_partitions(std_e::parallel_policy{4,16},std::move(w_par),proj);
+    CHECK( jv_par.flat_view() == expected_values_par );
+    CHECK( indices_of(jv_par) == expected_indices_par );
+
+    // a view is sorted in place, as with the other paths
+    vector<int> w_view = expected_values_par;
+    std::reverse(begin(w_view),end(w_view));
+    auto jv_view = std_e::sort_into_partitions(std_e::make_span(w_view),proj);
+    CHECK( w_view == expected_values );
+    CHECK( jv_view.flat_view() == expected_values );
+  }
+  SUBCASE("not default constructible: permuted in place") {
+    vector<no_default_ctor> w;
+    for (int i=0; i<100; ++i) {
+      w.emplace_back(i);
+    }
+    auto proj = [](no_default_ctor x){ return x.i%7; };
+    auto [expected_values,expected_indices] = expected_partitions(w,proj);
+    auto jv = std_e::sort_into_partitions(std::move(w),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+  }
+  SUBCASE("empty") {
+    auto jv = std_e::sort_into_partitions(vector<id_string>{},[](const id_string& x){ return x.id; });
+    CHECK( jv.size() == 0 );
+    CHECK( indices_of(jv) == vector{0} );
+  }
+}
+
+TEST_CASE("sort_into_partitions parallel") {
+  std_e::parallel_policy pol = {4,16}; // small grain to force several chunks
+  vector<id_string> v;
+  for (int i=0; i<1000; ++i) {
+    v.push_back({(i*37)%23-11,std::to_string(i)});
+  }
+
+  SUBCASE("counting sort") {
+    auto proj = [](const id_string& x){ return x.id; };
+    auto [expected_values,expected_indices] = expected_partitions(v,proj);
+    auto jv = std_e::sort_into_partitions(pol,std::move(v),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+  }
+  SUBCASE("bool") {
+    auto proj = [](const id_string& x){ return x.id%3==0; };
+    auto [expected_values,expected_indices] = expected_partitions(v,proj);
+    auto jv = std_e::sort_into_partitions(pol,std::move(v),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+  }
+  SUBCASE("spread integers") {
+    auto proj = [](const id_string& x){ return std::int64_t(x.id)<<40; };
+    auto [expected_values,expected_indices] = expected_partitions(v,proj);
+    auto jv = std_e::sort_into_partitions(pol,std::move(v),proj);
+    CHECK( jv.flat_view() == expected_values );
+    CHECK( indices_of(jv) == expected_indices );
+  }
+  SUBCASE("empty") {
+    auto jv = std_e::sort_into_partitions(pol,vector<id_string>{},[](const id_string& x){ return x.id; });
+    CHECK( jv.size() == 0 );
+  }
+}
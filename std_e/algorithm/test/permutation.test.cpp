@@ -2,6 +2,7 @@
 
 #include "std_e/algorithm/permutation.hpp"
 #include <vector>
+#include <string>
 using std::vector;
 
 
@@ -66,6 +67,34 @@ TEST_CASE("permute_copy_n") {
   CHECK( d_v == expected_d_v );
 }
 
+TEST_CASE("permute_copy_n blocked_gather") {
+  int sz = 1000;
+  vector<int> v(sz);
+  std::iota(begin(v),end(v),100);
+  vector<int> perm(sz);
+  for (int i=0; i<sz; ++i) {
+    perm[i] = (i*367)%sz; // 367 and 1000 are co-prime, so this is a permutation
+  }
+
+  std_e::blocked_gather_policy small_blocks = {16};
+  vector<int> d_v(sz);
+  std_e::permute_copy_n(small_blocks,v.begin(),d_v.begin(),perm.begin(),sz);
+  CHECK( d_v == std_e::permute_copy(v,perm) );
+
+  SUBCASE("permute_copy") {
+    CHECK( std_e::permute_copy(small_blocks,v,perm) == std_e::permute_copy(v,perm) );
+    CHECK( std_e::permute_copy(std_e::blocked_gather,v,perm) == std_e::permute_copy(v,perm) );
+    CHECK( std_e::permute_copy(std_e::direct_gather,v,perm) == std_e::permute_copy(v,perm) );
+  }
+  SUBCASE("compose_permutations") {
+    vector<int> p1(sz+37,0); // not a permutation, and of a different size
+    for (int i=0; i<sz+37; ++i) {
+      p1[i] = (i*i)%sz;
+    }
+    CHECK( std_e::compose_permutations(small_blocks,perm,p1) == std_e::compose_permutations(perm,p1) );
+  }
+}
+
 TEST_CASE("permute") {
   vector<double> v = { 3.14 , 2.7 , 6.67};
   vector<int> perm = {1,2,0};
@@ -77,6 +106,38 @@ TEST_CASE("permute") {
 }
 
 
+TEST_CASE("permutation_plan") {
+  vector<int> perm = {1,2,0,3,5,4}; // cycles: (0 1 2), (3), (4 5)
+  std_e::permutation_plan plan(perm);
+
+  CHECK( plan.size() == 6 );
+  CHECK( plan.n_cycle() == 2 );
+  CHECK( plan.n_moved() == 5 );
+
+  vector<double> v = {3.14, 2.7, 6.67, 1.41, 0.5, 1.62};
+  vector<std::string> w = {"A","B","C","D","E","F"};
+  vector<bool> b = {true,false,false,true,false,true};
+
+  SUBCASE("permute") {
+    std_e::permute(v,plan);
+    std_e::permute(w.begin(),plan);
+    CHECK( v == vector{2.7, 6.67, 3.14, 1.41, 1.62, 0.5} );
+    CHECK( w == vector<std::string>{"B","C","A","D","F","E"} );
+  }
+  SUBCASE("several ranges in one walk") {
+    plan.apply(v,w,b);
+    CHECK( v == vector{2.7, 6.67, 3.14, 1.41, 1.62, 0.5} );
+    CHECK( w == vector<std::string>{"B","C","A","D","F","E"} );
+    CHECK( b == vector<bool>{false,false,true,true,true,false} );
+  }
+  SUBCASE("apply_permutation") {
+    std_e::apply_permutation(plan,std::tie(v,w));
+    CHECK( v == vector{2.7, 6.67, 3.14, 1.41, 1.62, 0.5} );
+    CHECK( w == vector<std::string>{"B","C","A","D","F","E"} );
+  }
+}
+
+
 TEST_CASE("sort and permutations") {
   vector<int> v = {100, 90, 90, 100, 80, 80, 80, 70, 60};
 
@@ -112,6 +173,30 @@ TEST_CASE("sort and permutations") {
 }
 
 
+TEST_CASE("sort_permutation engines") {
+  vector<int> v = {100, 90, 90, 100, 80, 80, 80, 70, 60};
+  vector<int> expected = {8, 7, 4, 5, 6, 1, 2, 0, 3};
+
+  SUBCASE("by key") {
+    vector<std::pair<int,std::string>> x = {{100,"a"},{90,"b"},{90,"c"},{100,"d"},{80,"e"},{80,"f"},{80,"g"},{70,"h"},{60,"i"}};
+    CHECK( std_e::sort_permutation_by_key(x,[](const auto& e){ return e.first; }) == expected );
+  }
+  SUBCASE("indirect") {
+    vector<std::string> x = {"k","j","j","k","i","i","i","h","g"}; // std::string is not trivially copyable
+    auto p = std_e::sort_permutation(x);
+    CHECK( std_e::permute_copy(x,p) == vector<std::string>{"g","h","i","i","i","j","j","k","k"} );
+  }
+  SUBCASE("parallel") {
+    std_e::parallel_policy pol = {3,2};
+    CHECK( std_e::sort_permutation(pol,v) == expected );
+    CHECK( std_e::sort_permutation(pol,v,std::greater<>{}) == vector<int>{0, 3, 1, 2, 4, 5, 6, 7, 8} );
+
+    vector<std::string> x = {"k","j","j","k","i","i","i","h","g"};
+    CHECK( std_e::sort_permutation(pol,x) == expected );
+  }
+}
+
+
 TEST_CASE("unique permutations") {
   vector<int> v = {60, 70, 80, 80, 80, 90, 90, 100, 100};
 
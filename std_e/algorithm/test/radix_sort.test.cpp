@@ -0,0 +1,68 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/algorithm/radix_sort.hpp"
+#include "std_e/algorithm/permutation.hpp"
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+
+TEST_CASE("radix_bits") {
+  CHECK( std_e::radix_bits(-1) < std_e::radix_bits(0) );
+  CHECK( std_e::radix_bits(0) < std_e::radix_bits(1) );
+  CHECK( std_e::radix_bits(std::int64_t(-5)) < std_e::radix_bits(std::int64_t(3)) );
+  CHECK( std_e::radix_bits(-2.5) < std_e::radix_bits(-1.) );
+  CHECK( std_e::radix_bits(-1.) < std_e::radix_bits(0.) );
+  CHECK( std_e::radix_bits(0.f) < std_e::radix_bits(1e-30f) );
+  CHECK( std_e::radix_bits(1.f) < std_e::radix_bits(2.f) );
+}
+
+TEST_CASE("radix_sort") {
+  SUBCASE("signed integers") {
+    vector<int> v = {5,-12,0,3,1<<20,-8,1,9,-(1<<30),2,11,6,13,-4,7};
+    vector<int> expected = v;
+    sort(begin(expected),end(expected));
+
+    std_e::radix_sort(begin(v),end(v));
+    CHECK( v == expected );
+  }
+  SUBCASE("64-bit unsigned integers") {
+    vector<uint64_t> v = {5,uint64_t(1)<<40,0,3,uint64_t(-1),8};
+    vector<uint64_t> expected = {0,3,5,8,uint64_t(1)<<40,uint64_t(-1)};
+
+    std_e::radix_sort(begin(v),end(v));
+    CHECK( v == expected );
+  }
+  SUBCASE("floating point numbers") {
+    vector<double> v = {3.14,-2.7,0.,1e300,-1e-300,6.67,-100.};
+    vector<double> expected = {-100.,-2.7,-1e-300,0.,3.14,6.67,1e300};
+
+    std_e::radix_sort(begin(v),end(v));
+    CHECK( v == expected );
+  }
+  SUBCASE("projection and stability") {
+    vector<pair<int,char>> v = {{3,'a'},{1,'b'},{3,'c'},{-1,'d'},{1,'e'},{3,'f'}};
+    vector<pair<int,char>> expected = {{-1,'d'},{1,'b'},{1,'e'},{3,'a'},{3,'c'},{3,'f'}};
+
+    std_e::radix_sort(begin(v),end(v),[](const auto& x){ return x.first; });
+    CHECK( v == expected );
+  }
+}
+
+TEST_CASE("radix_sort_algo") {
+  vector<double> v = {100., 90., 90., 100., 80., 80., 80., 70., 60.};
+
+  CHECK( std_e::sort_permutation(v,std::less<>{},std_e::radix_sort_algo) == vector<int>{8, 7, 4, 5, 6, 1, 2, 0, 3} );
+  CHECK( std_e::sort_permutation(v,std::greater<>{},std_e::radix_sort_algo) == vector<int>{0, 3, 1, 2, 4, 5, 6, 7, 8} );
+
+  SUBCASE("large integer ranges are radix-sorted by default") {
+    int n = 5000;
+    vector<int> x(n);
+    for (int i=0; i<n; ++i) {
+      x[i] = (i*7919)%1000 - 500;
+    }
+    auto p = std_e::sort_permutation(x);
+    auto p_expected = std_e::sort_permutation(x,std::less<>{},[](auto f, auto l, auto comp){ std::stable_sort(f,l,comp); });
+    CHECK( p == p_expected );
+  }
+}
@@ -2,6 +2,11 @@
 
 #include "std_e/algorithm/sorting_networks.hpp"
 #include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 
 
 using namespace std;
@@ -125,3 +130,132 @@ TEST_CASE("sorting networks") {
     CHECK( v_35 == expected_v );
   }
 }
+
+TEST_CASE("generated sorting networks") {
+  CHECK( sorting_network_comparators<8>.size() == 19 );
+  CHECK( sorting_network_comparators<16>.size() == 63 );
+  CHECK( sorting_network_comparators<32>.size() == 191 );
+
+  SUBCASE("0-1 principle") {
+    // a network sorts every sequence if and only if it sorts every sequence of 0s and 1s
+    auto sorts_all_01_sequences = [](auto n_c){
+      constexpr int n = decltype(n_c)::value;
+      for (int bits=0; bits<(1<<n); ++bits) {
+        vector<int> v(n);
+        for (int i=0; i<n; ++i) v[i] = (bits>>i)&1;
+        sorting_network<n>::sort(begin(v));
+        if (!is_sorted(begin(v),end(v))) return false;
+      }
+      return true;
+    };
+    CHECK( sorts_all_01_sequences(std::integral_constant<int,5>{}) );
+    CHECK( sorts_all_01_sequences(std::integral_constant<int,7>{}) );
+    CHECK( sorts_all_01_sequences(std::integral_constant<int,12>{}) );
+    CHECK( sorts_all_01_sequences(std::integral_constant<int,16>{}) );
+  }
+}
+
+TEST_CASE("sort_small") {
+  for (int n=0; n<=40; ++n) {
+    vector<double> v(n);
+    for (int i=0; i<n; ++i) {
+      v[i] = (i*37)%17 - 0.5*i;
+    }
+    vector<double> expected = v;
+    sort(begin(expected),end(expected));
+
+    sort_small(begin(v),end(v));
+    CHECK( v == expected );
+  }
+
+  SUBCASE("non-arithmetic type") {
+    vector<string> v = {"face","vertex","edge","cell","node"};
+    sort_small(begin(v),end(v));
+    CHECK( v == vector<string>{"cell","edge","face","node","vertex"} );
+  }
+}
+
+TEST_CASE("sorting networks with NaN and signed zeros") {
+  // the result may not be sorted (NaN is unordered), but it must be a permutation of the input
+  auto bits = [](const vector<double>& v){
+    vector<std::uint64_t> res(v.size());
+    std::memcpy(res.data(),v.data(),v.size()*sizeof(double));
+    sort(begin(res),end(res));
+    return res;
+  };
+  double nan = std::numeric_limits<double>::quiet_NaN();
+
+  SUBCASE("two elements") {
+    double x0 = nan;
+    double x1 = 1.;
+    sort_network(x0,x1);
+    CHECK( bits({x0,x1}) == bits({nan,1.}) );
+
+    double z0 = 0.;
+    double z1 = -0.;
+    sort_network(z0,z1);
+    CHECK( bits({z0,z1}) == bits({0.,-0.}) );
+  }
+  SUBCASE("sort_small") {
+    vector<double> v = {nan,1.,3.,-0.};
+    vector<double> v_init = v;
+    sort_small(begin(v),end(v));
+    CHECK( bits(v) == bits(v_init) );
+
+    vector<double> w = {0.,-0.,2.,-0.,0.,1.,-1.};
+    vector<double> w_init = w;
+    sort_small(begin(w),end(w));
+    CHECK( bits(w) == bits(w_init) );
+    CHECK( is_sorted(begin(w),end(w)) );
+  }
+  SUBCASE("sort_rows") {
+    vector<double> v = {nan,1.,3.,-0.,  0.,-0.,nan,2.};
+    vector<double> v_init = v;
+    sort_rows<4>(make_strided_span<4>(v));
+    CHECK( bits({v[0],v[1],v[2],v[3]}) == bits({v_init[0],v_init[1],v_init[2],v_init[3]}) );
+    CHECK( bits({v[4],v[5],v[6],v[7]}) == bits({v_init[4],v_init[5],v_init[6],v_init[7]}) );
+  }
+}
+
+TEST_CASE("sort_rows") {
+  auto rows_are_sorted = [](const vector<int>& v, int n_row, int stride, int k){
+    for (int r=0; r<n_row; ++r) {
+      if (!is_sorted(begin(v)+r*stride,begin(v)+r*stride+k)) return false;
+    }
+    return true;
+  };
+  auto make_rows = [](int n_row, int stride){
+    vector<int> v(n_row*stride);
+    for (int i=0; i<n_row*stride; ++i) {
+      v[i] = (i*7919)%101 - 50;
+    }
+    return v;
+  };
+
+  SUBCASE("contiguous rows") {
+    int n_row = 37; // not a multiple of the batch size: the remaining rows are sorted one by one
+    vector<int> v = make_rows(n_row,3);
+    sort_rows<3>(make_strided_span<3>(v));
+    CHECK( rows_are_sorted(v,n_row,3,3) );
+
+    vector<int> w = make_rows(n_row,27);
+    vector<int> w_expected = w;
+    sort_rows<27>(make_strided_span<27>(w));
+    for (int r=0; r<n_row; ++r) {
+      sort(begin(w_expected)+r*27,begin(w_expected)+(r+1)*27);
+    }
+    CHECK( w == w_expected );
+  }
+  SUBCASE("padded rows") {
+    int n_row = 40;
+    int stride = 10;
+    vector<int> v = make_rows(n_row,stride);
+    vector<int> v_init = v;
+    sort_rows<8>(make_strided_span(v.data(),n_row,stride));
+    CHECK( rows_are_sorted(v,n_row,stride,8) );
+    for (int r=0; r<n_row; ++r) { // padding is not touched
+      CHECK( v[r*stride+8] == v_init[r*stride+8] );
+      CHECK( v[r*stride+9] == v_init[r*stride+9] );
+    }
+  }
+}
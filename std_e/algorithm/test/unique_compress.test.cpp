@@ -3,6 +3,8 @@
 #include "std_e/algorithm/unique_compress.hpp"
 #include "std_e/algorithm/algorithm.hpp"
 #include <vector>
+#include <algorithm>
+#include <memory>
 #include "std_e/unit_test/id_string.hpp"
 #include "std_e/utils/concatenate.hpp"
 using namespace std;
@@ -76,6 +78,58 @@ TEST_CASE("unique_compress_copy_with_index_position") {
   CHECK( positions_old_to_new == expected_positions_old_to_new );
 }
 
+TEST_CASE("unique_compress parallel") {
+  // groups of various lengths, some of them spanning several chunks
+  const vector<id_string> v = {{40,"0"},{41,"a"},{42,"b"},{42,"c"},{42,"d"},{42,"e"},{42,"f"},{42,"g"},{43,"h"},{44,"i"},{44,"j"},{45,"k"},{46,"l"}};
+  // no side effect: may be called concurrently, and from the middle of a group
+  auto compress_while_eq = [](auto f, auto l){ return std::find_if_not(f,l,[f](const auto& x){ return equal_ids(*f,x); }); };
+
+  vector<id_string> expected = {{40,"0"},{41,"a"},{42,"b"},{43,"h"},{44,"i"},{45,"k"},{46,"l"}};
+  vector<int> expected_positions_old_to_new = {10,11,12,12,12,12,12,12,13,14,14,15,16};
+
+  for (int n_thread : {1,2,3,5,13}) {
+    std_e::parallel_policy pol = {n_thread,1};
+
+    vector<id_string> v0 = v;
+    auto pos = std_e::unique_compress(pol,begin(v0),end(v0),compress_while_eq);
+    CHECK( vector<id_string>(begin(v0),pos) == expected );
+
+    vector<id_string> res(v.size());
+    auto res_end = std_e::unique_compress_copy(pol,begin(v),end(v),begin(res),compress_while_eq);
+    CHECK( vector<id_string>(begin(res),res_end) == expected );
+
+    vector<id_string> compress_res(v.size());
+    vector<int> positions_old_to_new(v.size());
+    res_end = std_e::unique_compress_copy_with_index_position(
+      pol,
+      begin(v),end(v),
+      begin(compress_res),
+      10,begin(positions_old_to_new),
+      compress_while_eq
+    );
+    CHECK( vector<id_string>(begin(compress_res),res_end) == expected );
+    CHECK( positions_old_to_new == expected_positions_old_to_new );
+  }
+}
+
+TEST_CASE("unique_compress parallel, move-only elements") {
+  // the elements are moved in place, never copied
+  vector<int> ids = {0,1,1,1,2,3,3,4,4,4,4,5};
+  auto compress_while_eq = [](auto f, auto l){ return std::find_if_not(f,l,[f](const auto& x){ return *x==**f; }); };
+
+  for (int n_thread : {1,2,3,5,12}) {
+    std_e::parallel_policy pol = {n_thread,1};
+
+    vector<unique_ptr<int>> v;
+    for (int id : ids) v.push_back(make_unique<int>(id));
+    auto pos = std_e::unique_compress(pol,begin(v),end(v),compress_while_eq);
+    REQUIRE( pos-begin(v) == 6 );
+    for (int i=0; i<6; ++i) {
+      CHECK( *v[i] == i );
+    }
+  }
+}
+
 TEST_CASE("unique_compress_stride_copy") {
   const vector<int> v =       {10,11,12,13,14,15,16,17,18,19};
   const vector<int> strides = {1 ,2    ,1 ,1 ,1 ,3       ,1 };
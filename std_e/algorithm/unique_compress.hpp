@@ -2,6 +2,9 @@
 
 
 #include <iterator>
+#include <vector>
+#include <algorithm>
+#include "std_e/execution/execution.hpp"
 
 
 namespace std_e {
@@ -30,23 +33,12 @@ template<class Fwd_it, class S, class Output_it, class F> constexpr auto
 // requires F(Fwd_it,S)->Fwd_it
 // requires Sentinel<Fwd_it>==S
 unique_compress_copy(Fwd_it first, S last, Output_it result, F compress_while_eq) -> Output_it {
-  if (first==last) return result;
-
-  *result = *first;
-  Fwd_it next = compress_while_eq(first,last);
-  while (next!=last && next==std::next(first)) {
-    first = next;
-    next = compress_while_eq(first,last);
-    *result=*first;
-    ++result;
-  }
-  while (next!=last) {
-    first = next;
-    next = compress_while_eq(first,last);
-    ++result;
+  while (first!=last) {
     *result = *first;
+    ++result;
+    first = compress_while_eq(first,last);
   }
-  return ++result;
+  return result;
 }
 
 template<class Fwd_it, class S, class Output_it0, class I, class Output_it1, class F> constexpr auto
@@ -61,10 +53,10 @@ unique_compress_copy_with_index_position(
     F compress_while_eq
 ) -> Output_it0
 {
-  auto f = [&current_new_position,old_to_new_positions,compress_while_eq](auto f, auto l){
+  auto f = [&current_new_position,&old_to_new_positions,compress_while_eq](auto f, auto l){
     auto next = compress_while_eq(f,l);
     auto n = next-f;
-    std::fill_n(old_to_new_positions,n,current_new_position);
+    old_to_new_positions = std::fill_n(old_to_new_positions,n,current_new_position);
     ++current_new_position;
     return next;
   };
@@ -72,6 +64,135 @@ unique_compress_copy_with_index_position(
 }
 
 
+// parallel versions {
+/**
+  Parallel versions of unique_compress, unique_compress_copy and unique_compress_copy_with_index_position
+  Algorithm:
+    1. The range is split in chunks. Chunk boundaries are moved to the next group start
+       (the start of chunk `i` becomes the end of the group of the last element of chunk `i-1`)
+    2. Each chunk is compressed independently (in place for unique_compress)
+    3. An exclusive scan of the number of groups of each chunk gives the output position of each chunk
+    4. The chunk results are copied to their output position in parallel
+       (for unique_compress, they are moved left sequentially, since the chunks may overlap)
+  Requirements, in addition to the ones of the sequential versions:
+    - the iterators are random access iterators
+    - `compress_while_eq` can be called concurrently
+    - `compress_while_eq(f,l)` returns the end of the group of `*f` even if `f` is not the first element of its group
+      (true if groups are runs of equivalent adjacent elements)
+      It is called once more per chunk for step 1, and the groups of a chunk are compressed in order
+*/
+namespace detail {
+  /// start of each chunk, moved to the next group start (size: n_chunk+1)
+  template<class Rand_it, class F> auto
+  unique_compress_chunk_starts(const parallel_policy& pol, Rand_it first, Rand_it last, F compress_while_eq) -> std::vector<Rand_it> {
+    using I = typename std::iterator_traits<Rand_it>::difference_type;
+    I n = last-first;
+    int n_chk = n_chunk(pol,n);
+    std::vector<Rand_it> starts(n_chk+1,last);
+    starts[0] = first;
+    for_each_chunk(n_chk,n,[&](int i, I start, I){
+      if (i>0) starts[i] = compress_while_eq(first+start-1,last); // end of the group of the element before the chunk
+    });
+    for (int i=1; i<n_chk; ++i) { // a group may span several chunks
+      starts[i] = std::max(starts[i],starts[i-1]);
+    }
+    return starts;
+  }
+
+  template<class I> auto
+  exclusive_scan_counts(const std::vector<I>& counts) -> std::vector<I> {
+    std::vector<I> offsets(counts.size()+1,0);
+    for (size_t i=0; i<counts.size(); ++i) {
+      offsets[i+1] = offsets[i]+counts[i];
+    }
+    return offsets;
+  }
+}
+
+template<class Rand_it, class F> auto
+unique_compress(const parallel_policy& pol, Rand_it first, Rand_it last, F compress_while_eq) -> Rand_it {
+  using I = typename std::iterator_traits<Rand_it>::difference_type;
+  auto starts = detail::unique_compress_chunk_starts(pol,first,last,compress_while_eq);
+  int n_chk = starts.size()-1;
+  if (n_chk<=1) return unique_compress(first,last,compress_while_eq);
+
+  // each chunk is compressed in place, at its start
+  std::vector<I> counts(n_chk);
+  for_each_chunk(n_chk,n_chk,[&](int i, int, int){
+    if (starts[i]!=starts[i+1]) { // a chunk is empty if a group spans it entirely
+      counts[i] = unique_compress(starts[i],starts[i+1],compress_while_eq) - starts[i];
+    } else {
+      counts[i] = 0;
+    }
+  });
+  auto offsets = detail::exclusive_scan_counts(counts);
+
+  // then the chunks are moved left, in order: the destination of a chunk
+  // may overlap the compressed elements of the previous one, so this is sequential
+  for (int i=1; i<n_chk; ++i) {
+    if (first+offsets[i]!=starts[i]) { // no self-move
+      std::move(starts[i],starts[i]+counts[i],first+offsets[i]);
+    }
+  }
+  return first+offsets[n_chk];
+}
+
+template<class Rand_it0, class Rand_it1, class F> auto
+unique_compress_copy(const parallel_policy& pol, Rand_it0 first, Rand_it0 last, Rand_it1 result, F compress_while_eq) -> Rand_it1 {
+  using I = typename std::iterator_traits<Rand_it0>::difference_type;
+  auto starts = detail::unique_compress_chunk_starts(pol,first,last,compress_while_eq);
+  int n_chk = starts.size()-1;
+
+  // count, then write at the right place: no intermediate buffer
+  std::vector<I> counts(n_chk,0);
+  for_each_chunk(n_chk,n_chk,[&](int i, int, int){
+    for (auto f=starts[i]; f!=starts[i+1]; f=compress_while_eq(f,starts[i+1])) {
+      ++counts[i];
+    }
+  });
+  auto offsets = detail::exclusive_scan_counts(counts);
+
+  for_each_chunk(n_chk,n_chk,[&](int i, int, int){
+    unique_compress_copy(starts[i],starts[i+1],result+offsets[i],compress_while_eq);
+  });
+  return result+offsets[n_chk];
+}
+
+template<class Rand_it0, class Rand_it1, class I, class Rand_it2, class F> auto
+unique_compress_copy_with_index_position(
+    const parallel_policy& pol,
+    Rand_it0 first, Rand_it0 last,
+    Rand_it1 result,
+    I current_new_position,
+    Rand_it2 old_to_new_positions,
+    F compress_while_eq
+) -> Rand_it1
+{
+  using J = typename std::iterator_traits<Rand_it0>::difference_type;
+  auto starts = detail::unique_compress_chunk_starts(pol,first,last,compress_while_eq);
+  int n_chk = starts.size()-1;
+
+  std::vector<J> counts(n_chk,0);
+  for_each_chunk(n_chk,n_chk,[&](int i, int, int){
+    for (auto f=starts[i]; f!=starts[i+1]; f=compress_while_eq(f,starts[i+1])) {
+      ++counts[i];
+    }
+  });
+  auto offsets = detail::exclusive_scan_counts(counts);
+
+  for_each_chunk(n_chk,n_chk,[&](int i, int, int){
+    unique_compress_copy_with_index_position(
+      starts[i],starts[i+1],
+      result+offsets[i],
+      I(current_new_position+offsets[i]),old_to_new_positions+(starts[i]-first),
+      compress_while_eq
+    );
+  });
+  return result+offsets[n_chk];
+}
+// parallel versions }
+
+
 // TODO generalize int*, see if can be formulated as other of unique_compress family
 template<
   class Fwd_it, class S, class Fwd_it2, class F,
@@ -0,0 +1,270 @@
+#pragma once
+
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <functional>
+
+
+namespace std_e {
+
+
+/**
+  Minimal micro-benchmark harness
+    - a benchmark is a function taking a `benchmark_state&`, registered with `STD_E_BENCHMARK(name,sizes...)`
+    - the function is called once per size, and should call `state.run(setup,kernel)`
+    - `kernel` is timed `state.n_repetition()` times, `setup` is called (untimed) before each repetition
+    - results are written in JSON, so they can be compared between releases
+*/
+class benchmark_state {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    benchmark_state(std::int64_t n, int n_rep)
+      : n(n)
+      , n_rep(n_rep)
+      , n_items(n)
+    {}
+
+    auto size() const -> std::int64_t {
+      return n;
+    }
+    auto n_repetition() const -> int {
+      return n_rep;
+    }
+
+    template<class Setup, class Kernel> auto
+    run(Setup setup, Kernel kernel) -> void {
+      times.clear();
+      for (int i=0; i<n_rep; ++i) {
+        setup();
+        auto start = clock::now();
+        kernel();
+        auto finish = clock::now();
+        std::chrono::duration<double> elapsed = finish-start;
+        times.push_back(elapsed.count());
+      }
+    }
+    template<class Kernel> auto
+    run(Kernel kernel) -> void {
+      run([](){},kernel);
+    }
+
+    /// by default, the number of items processed by one kernel call is the benchmark size
+    auto set_items_processed(std::int64_t n_it) -> void {
+      n_items = n_it;
+    }
+    auto items_processed() const -> std::int64_t {
+      return n_items;
+    }
+    auto timings() const -> const std::vector<double>& {
+      return times;
+    }
+
+  private:
+    std::int64_t n;
+    int n_rep;
+    std::int64_t n_items;
+    std::vector<double> times;
+};
+
+
+// prevent the compiler from optimizing away a computation whose result is not used
+// REF: google benchmark DoNotOptimize
+template<class T> inline auto
+do_not_optimize(T& x) -> void {
+#if defined(__GNUC__)
+  asm volatile("" : "+m,r"(x) : : "memory");
+#else
+  static volatile char sink;
+  sink = *reinterpret_cast<volatile char*>(&x);
+#endif
+}
+template<class T> inline auto
+do_not_optimize(const T& x) -> void {
+#if defined(__GNUC__)
+  asm volatile("" : : "m"(x) : "memory");
+#else
+  static volatile char sink;
+  sink = *reinterpret_cast<const volatile char*>(&x);
+#endif
+}
+
+
+// registry {
+struct benchmark_case {
+  std::string name;
+  std::vector<std::int64_t> sizes;
+  std::function<void(benchmark_state&)> f;
+};
+
+inline auto
+benchmark_registry() -> std::vector<benchmark_case>& {
+  static std::vector<benchmark_case> reg;
+  return reg;
+}
+
+inline auto
+register_benchmark(std::string name, std::vector<std::int64_t> sizes, std::function<void(benchmark_state&)> f) -> int {
+  benchmark_registry().push_back({std::move(name),std::move(sizes),std::move(f)});
+  return 0;
+}
+// registry }
+
+
+// results {
+struct benchmark_result {
+  std::string name;
+  std::int64_t size;
+  std::int64_t items;
+  std::vector<double> times;
+};
+
+namespace detail {
+  inline auto
+  json_escape(const std::string& s) -> std::string {
+    std::string res;
+    for (char c : s) {
+      if (c=='"' || c=='\\') res += '\\';
+      res += c;
+    }
+    return res;
+  }
+}
+
+inline auto
+to_json(const std::vector<benchmark_result>& results) -> std::string {
+  std::ostringstream os;
+  os << std::setprecision(6) << std::scientific;
+  os << "{\n";
+  os << "  \"context\": {\n";
+  os << "    \"library\": \"std_e\",\n";
+#if defined(__VERSION__)
+  os << "    \"compiler\": \"" << detail::json_escape(__VERSION__) << "\",\n";
+#endif
+  os << "    \"cplusplus\": " << __cplusplus << ",\n";
+#ifdef NDEBUG
+  os << "    \"ndebug\": true\n";
+#else
+  os << "    \"ndebug\": false\n";
+#endif
+  os << "  },\n";
+  os << "  \"benchmarks\": [";
+  for (size_t i=0; i<results.size(); ++i) {
+    const auto& r = results[i];
+    std::vector<double> ts = r.times;
+    std::sort(begin(ts),end(ts));
+    int n_rep = ts.size();
+    double t_min = n_rep>0 ? ts[0] : 0.;
+    double t_max = n_rep>0 ? ts[n_rep-1] : 0.;
+    double t_median = n_rep>0 ? ts[n_rep/2] : 0.;
+    double t_mean = n_rep>0 ? std::accumulate(begin(ts),end(ts),0.)/n_rep : 0.;
+    double items_per_s = t_min>0. ? r.items/t_min : 0.;
+
+    os << (i==0 ? "\n" : ",\n");
+    os << "    {";
+    os << "\"name\": \"" << detail::json_escape(r.name) << "\", ";
+    os << "\"size\": " << r.size << ", ";
+    os << "\"repetitions\": " << n_rep << ", ";
+    os << "\"min_s\": " << t_min << ", ";
+    os << "\"median_s\": " << t_median << ", ";
+    os << "\"mean_s\": " << t_mean << ", ";
+    os << "\"max_s\": " << t_max << ", ";
+    os << "\"items_per_second\": " << items_per_s;
+    os << "}";
+  }
+  os << "\n  ]\n";
+  os << "}\n";
+  return os.str();
+}
+// results }
+
+
+// driver {
+struct benchmark_options {
+  std::string filter = "";
+  int n_repetition = 5;
+  std::int64_t max_size = -1;
+};
+
+namespace detail {
+  [[noreturn]] inline auto
+  exit_with_usage(const char* prog_name, const std::string& error_msg) -> void {
+    std::cerr << "std_e benchmarks: " << error_msg << "\n"
+              << "usage: " << prog_name << " [--filter=<substring>] [--repetitions=<n>] [--max_size=<n>]\n";
+    std::exit(1);
+  }
+}
+
+/// Prints the usage and exits with a non-zero code if an option is unknown or its value is not a number
+inline auto
+parse_benchmark_options(int argc, char** argv) -> benchmark_options {
+  benchmark_options opts;
+  for (int i=1; i<argc; ++i) {
+    std::string arg = argv[i];
+    auto value_of = [&arg](const std::string& key) { return arg.substr(key.size()); };
+    try {
+      if (arg.rfind("--filter=",0)==0) {
+        opts.filter = value_of("--filter=");
+      } else if (arg.rfind("--repetitions=",0)==0) {
+        opts.n_repetition = std::stoi(value_of("--repetitions="));
+      } else if (arg.rfind("--max_size=",0)==0) {
+        opts.max_size = std::stoll(value_of("--max_size="));
+      } else {
+        detail::exit_with_usage(argv[0],"unknown option \""+arg+"\"");
+      }
+    } catch (const std::logic_error&) { // std::invalid_argument or std::out_of_range
+      detail::exit_with_usage(argv[0],"invalid value in \""+arg+"\"");
+    }
+  }
+  return opts;
+}
+
+inline auto
+run_benchmarks(const benchmark_options& opts) -> std::vector<benchmark_result> {
+  std::vector<benchmark_result> results;
+  for (const auto& bc : benchmark_registry()) {
+    if (bc.name.find(opts.filter)==std::string::npos) continue;
+    for (auto n : bc.sizes) {
+      if (opts.max_size>=0 && n>opts.max_size) continue;
+      benchmark_state state(n,opts.n_repetition);
+      bc.f(state);
+      results.push_back({bc.name,n,state.items_processed(),state.timings()});
+    }
+  }
+  return results;
+}
+
+inline auto
+benchmark_main(int argc, char** argv) -> int {
+  auto opts = parse_benchmark_options(argc,argv);
+  auto results = run_benchmarks(opts);
+  std::cout << to_json(results);
+  return 0;
+}
+// driver }
+
+
+} // std_e
+
+
+#define STD_E_BENCHMARK_CONCAT__IMPL(x,y) x##y
+#define STD_E_BENCHMARK_CONCAT(x,y) STD_E_BENCHMARK_CONCAT__IMPL(x,y)
+
+#define STD_E_BENCHMARK__IMPL(f_name, bench_name, ...) \
+  static void f_name(std_e::benchmark_state& state); \
+  [[maybe_unused]] static int STD_E_BENCHMARK_CONCAT(f_name,_registered) = std_e::register_benchmark(bench_name,{__VA_ARGS__},f_name); \
+  static void f_name(std_e::benchmark_state& state)
+
+/// Usage: STD_E_BENCHMARK("my_algo", 1<<10, 1<<20) { ... state.run(...); }
+#define STD_E_BENCHMARK(bench_name, ...) \
+  STD_E_BENCHMARK__IMPL(STD_E_BENCHMARK_CONCAT(std_e_benchmark_,__LINE__), bench_name, __VA_ARGS__)
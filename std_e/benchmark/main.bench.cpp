@@ -0,0 +1,6 @@
+#include "std_e/benchmark/benchmark.hpp"
+
+
+int main(int argc, char** argv) {
+  return std_e::benchmark_main(argc,argv);
+}
@@ -0,0 +1,53 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/data_structure/jagged_range.hpp"
+#include <random>
+
+using namespace std_e;
+
+
+namespace {
+
+
+auto
+random_jagged_vector(std::int64_t n_elt, int max_interval_size) -> jagged_vector<int> {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> interval_size(1,max_interval_size);
+  std::vector<int> values(n_elt);
+  std::iota(begin(values),end(values),0);
+  std::vector<int> indices = {0};
+  while (indices.back()<n_elt) {
+    indices.push_back(std::min<std::int64_t>(indices.back()+interval_size(gen),n_elt));
+  }
+  return {std::move(values),std::move(indices)};
+}
+
+
+STD_E_BENCHMARK("jagged_range/iterate_intervals", 1<<10, 1<<16, 1<<20) {
+  auto jv = random_jagged_vector(state.size(),8);
+
+  long long s = 0;
+  state.run([&](){
+    int n_interval = jv.size();
+    for (int i=0; i<n_interval; ++i) {
+      for (int x : jv[i]) {
+        s += x;
+      }
+    }
+    do_not_optimize(s);
+  });
+}
+
+STD_E_BENCHMARK("jagged_range/iterate_flat", 1<<10, 1<<16, 1<<20) {
+  auto jv = random_jagged_vector(state.size(),8);
+
+  long long s = 0;
+  state.run([&](){
+    for (int x : jv.flat_view()) {
+      s += x;
+    }
+    do_not_optimize(s);
+  });
+}
+
+
+} // anonymous
@@ -0,0 +1,142 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/data_structure/multi_range.hpp"
+#include <random>
+
+using namespace std_e;
+
+
+namespace {
+
+
+auto
+sorted_multi_vector(std::int64_t n) -> multi_vector<int,double> {
+  multi_vector<int,double> x;
+  for (std::int64_t i=0; i<n; ++i) {
+    x.push_back(int(2*i),double(i));
+  }
+  sort_by<0>(x);
+  return x;
+}
+auto
+random_queries(std::int64_t n, int n_query) -> std::vector<int> {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> distrib(0,int(2*n));
+  std::vector<int> qs(n_query);
+  for (int& q : qs) q = distrib(gen);
+  return qs;
+}
+
+constexpr int n_query = 1<<12;
+
+STD_E_BENCHMARK("multi_range/find_index_sorted/std_lower_bound", 1<<10, 1<<16, 1<<22) {
+  auto x = sorted_multi_vector(state.size());
+  auto qs = random_queries(state.size(),n_query);
+  state.set_items_processed(n_query);
+
+  const auto& r = range<0>(x);
+  state.run([&](){
+    for (int q : qs) {
+      auto i = std::lower_bound(begin(r),end(r),q)-begin(r);
+      do_not_optimize(i);
+    }
+  });
+}
+
+STD_E_BENCHMARK("multi_range/find_index_sorted/branchless", 1<<10, 1<<16, 1<<22) {
+  auto x = sorted_multi_vector(state.size());
+  auto qs = random_queries(state.size(),n_query);
+  state.set_items_processed(n_query);
+
+  state.run([&](){
+    for (int q : qs) {
+      auto i = x.find_index<0>(q);
+      do_not_optimize(i);
+    }
+  });
+}
+
+
+auto
+unsorted_multi_vector(std::int64_t n) -> multi_vector<int,double> {
+  multi_vector<int,double> x;
+  for (std::int64_t i=0; i<n; ++i) {
+    x.push_back(int(2*((i*7919)%n)),double(i));
+  }
+  return x;
+}
+
+STD_E_BENCHMARK("multi_range/find_index_unsorted/linear", 1<<10, 1<<14, 1<<18) {
+  auto x = unsorted_multi_vector(state.size());
+  auto qs = random_queries(state.size(),n_query);
+  state.set_items_processed(n_query);
+
+  state.run([&](){
+    for (int q : qs) {
+      auto i = x.find_index<0>(q);
+      do_not_optimize(i);
+    }
+  });
+}
+
+STD_E_BENCHMARK("multi_range/find_index_unsorted/hash_index", 1<<10, 1<<14, 1<<18) {
+  auto x = unsorted_multi_vector(state.size());
+  auto qs = random_queries(state.size(),n_query);
+  state.set_items_processed(n_query);
+
+  x.enable_hash_index<0>();
+  x.build_hash_index<0>();
+  state.run([&](){
+    for (int q : qs) {
+      auto i = x.find_index<0>(q);
+      do_not_optimize(i);
+    }
+  });
+}
+
+STD_E_BENCHMARK("multi_range/build_hash_index", 1<<10, 1<<16, 1<<20) {
+  auto x = unsorted_multi_vector(state.size());
+  state.set_items_processed(state.size());
+
+  x.enable_hash_index<0>();
+  state.run([&](){
+    x.build_hash_index<0>();
+  });
+}
+
+
+STD_E_BENCHMARK("multi_range/axpy/tuple_access", 1<<10, 1<<16, 1<<20) {
+  multi_vector<double,double> x;
+  for (std::int64_t i=0; i<state.size(); ++i) {
+    x.push_back(double(i),1.);
+  }
+  state.set_items_processed(state.size());
+
+  state.run([&](){
+    std::ptrdiff_t n = x.size();
+    for (std::ptrdiff_t i=0; i<n; ++i) {
+      auto [a,b] = x[i];
+      b += 0.5*a;
+    }
+    do_not_optimize(x);
+  });
+}
+
+STD_E_BENCHMARK("multi_range/axpy/batches", 1<<10, 1<<16, 1<<20) {
+  aligned_multi_vector<double,double> x;
+  for (std::int64_t i=0; i<state.size(); ++i) {
+    x.push_back(double(i),1.);
+  }
+  state.set_items_processed(state.size());
+
+  state.run([&](){
+    for_each_batch<8>(x,[](auto n, const double* a, double* b){
+      for (int i=0; i<n; ++i) {
+        b[i] += 0.5*a[i];
+      }
+    });
+    do_not_optimize(x);
+  });
+}
+
+
+} // anonymous
@@ -0,0 +1,146 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include "std_e/future/is_detected.hpp"
+
+
+namespace std_e {
+
+
+template<class T> using std_hash_result_t = decltype(std::hash<T>{}(std::declval<const T&>()));
+template<class T> constexpr bool is_std_hashable = is_detected_v<std_hash_result_t,T>;
+
+
+/**
+  Open-addressing hash index over a random access range:
+  maps each value of the range to the position of its first occurrence
+    - linear probing, with a table at least twice as big as the range
+    - only positions are stored: the values are compared in the range itself, so they are not duplicated
+  The index does not track the modifications of the range: it must be rebuilt if the range is changed
+  ensure_built can be called concurrently, also with find: the index is built under a lock, and only once
+  build, invalidate and the modifications of the range cannot be called concurrently with ensure_built or find
+*/
+class column_hash_index {
+  public:
+    using index_type = std::ptrdiff_t;
+
+  // ctors (each index has its own mutex, that is not copied nor moved)
+  //   the move ctor allocates a new mutex, so it is not noexcept
+  //   the moved-from index is not built anymore
+    column_hash_index() = default;
+    column_hash_index(const column_hash_index& x)
+      : slots(x.slots)
+      , shift(x.shift)
+      , mask(x.mask)
+      , built_size(x.built_size.load())
+    {}
+    column_hash_index(column_hash_index&& x)
+      : slots(std::move(x.slots))
+      , shift(x.shift)
+      , mask(x.mask)
+      , built_size(x.built_size.exchange(-1))
+    {}
+    auto operator=(const column_hash_index& x) -> column_hash_index& {
+      slots = x.slots;
+      shift = x.shift;
+      mask = x.mask;
+      built_size = x.built_size.load();
+      return *this;
+    }
+    auto operator=(column_hash_index&& x) noexcept -> column_hash_index& {
+      slots = std::move(x.slots);
+      shift = x.shift;
+      mask = x.mask;
+      built_size = x.built_size.exchange(-1);
+      return *this;
+    }
+
+  // build
+    template<class Range> auto
+    build(const Range& r) -> void {
+      std::lock_guard<std::mutex> lock(*build_mutex);
+      build__impl(r);
+    }
+    /// builds the index if it has not been built for a range of the size of `r`
+    template<class Range> auto
+    ensure_built(const Range& r) -> void {
+      index_type n = r.size();
+      if (built_size.load(std::memory_order_acquire)==n) return;
+      std::lock_guard<std::mutex> lock(*build_mutex);
+      if (built_size.load(std::memory_order_relaxed)!=n) { // not built by another thread in the meantime
+        build__impl(r);
+      }
+    }
+
+  // lookup
+    /// position of the first occurrence of `x` in `r`, or r.size() if not found
+    /// Precondition: the index has been built for `r`
+    template<class Range, class T> auto
+    find(const Range& r, const T& x) const -> index_type {
+      std::size_t s = slot(std::hash<T>{}(x));
+      while (slots[s]!=empty) {
+        if (r[slots[s]]==x) return slots[s];
+        s = (s+1) & mask;
+      }
+      return r.size();
+    }
+
+    auto
+    is_built_for(index_type n) const -> bool {
+      return built_size.load(std::memory_order_acquire)==n;
+    }
+    /// the memory is kept for the next build
+    auto
+    invalidate() -> void {
+      built_size.store(-1,std::memory_order_relaxed);
+    }
+  private:
+    static constexpr index_type empty = -1;
+
+    template<class Range> auto
+    build__impl(const Range& r) -> void {
+      using T = std::remove_cv_t<std::remove_reference_t<decltype(r[0])>>;
+      index_type n = r.size();
+      int log2_n_slot = 1;
+      while ((index_type(1)<<log2_n_slot) < 2*n) ++log2_n_slot;
+      shift = 64-log2_n_slot;
+      mask = (std::size_t(1)<<log2_n_slot) - 1;
+      slots.assign(mask+1,empty);
+
+      std::hash<T> h;
+      for (index_type i=0; i<n; ++i) {
+        std::size_t s = slot(h(r[i]));
+        while (slots[s]!=empty && !(r[slots[s]]==r[i])) {
+          s = (s+1) & mask;
+        }
+        if (slots[s]==empty) { // else, keep the first occurrence
+          slots[s] = i;
+        }
+      }
+      built_size.store(n,std::memory_order_release); // last: the index is complete when seen as built
+    }
+
+    auto
+    slot(std::size_t h) const -> std::size_t {
+      // Fibonacci hashing: std::hash of integers is the identity,
+      // so the bits are mixed to spread keys with a regular stride
+      return (std::uint64_t(h)*0x9E3779B97F4A7C15ull) >> shift;
+    }
+
+    std::vector<index_type> slots;
+    int shift = 63;
+    std::size_t mask = 0;
+    std::atomic<index_type> built_size = -1;
+    std::unique_ptr<std::mutex> build_mutex = std::make_unique<std::mutex>();
+};
+
+
+} // std_e
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "std_e/algorithm/permutation.hpp"
+#include "std_e/algorithm/algorithm.hpp"
 #include "std_e/base/template_alias.hpp"
 #include "std_e/future/contract.hpp"
 #include "std_e/data_structure/heterogenous_vector.hpp"
+#include "std_e/data_structure/column_hash_index.hpp"
 #include "std_e/algorithm/permutation.hpp"
 #include "std_e/future/span.hpp"
+#include "std_e/memory_ressource/aligned_allocator.hpp"
+#include <array>
+#include <optional>
 
 
 namespace std_e {
@@ -15,6 +20,11 @@ namespace std_e {
 // Invariants:
 //   (1) all ranges have the same length
 //   (2) if a range has been sorted, calls to find on it will use a binary search
+//   (3) if a hash index has been enabled on a range (see enable_hash_index), calls to find on it will use the hash index
+//       The index is built on the first find (under a lock, so concurrent const calls to find are safe),
+//       and invalidated by the member functions that modify the ranges,
+//       except the element accesses (operator[], back, find...): if an element of the range is modified through them,
+//       invalidate_hash_indices() must be called
 template<template<class> class range_template, class... Ts>
 class multi_range {
   public:
@@ -58,6 +68,7 @@ class multi_range {
     }
     template<int index> auto
     range() -> auto& {
+      invalidate_hash_index<index>();
       return get<index>(_impl); // TODO return span to enforce invariant (1)
     }
     template<class T> auto
@@ -66,6 +77,7 @@ class multi_range {
     }
     template<class T> auto
     range() -> auto& {
+      invalidate_hash_indices();
       return get<T>(_impl);
     }
 
@@ -89,6 +101,7 @@ class multi_range {
   // low-level access
     constexpr auto
     impl() -> impl_type& {
+      invalidate_hash_indices();
       return _impl;
     }
     constexpr auto
@@ -96,15 +109,31 @@ class multi_range {
       return _impl;
     }
 
+    /// If a hash index is enabled on range `index`, the first call builds it:
+    /// concurrent calls are safe (the build is locked), but the first one pays for the build
     template<int index, class T> constexpr auto
     // requires T==Ts[index]
     find_index(const T& x) const -> index_type {
       static_assert(index < nb_ranges());
       const auto& range = get<index>(_impl);
       if (index==sorted_rng_idx) {
-        auto it = std::lower_bound(begin(range),end(range),x);
-        return it-begin(range);
+        using elt_type = std::remove_cv_t<std::remove_reference_t<decltype(range[0])>>;
+        if constexpr (std::is_arithmetic_v<elt_type> && std::is_same_v<T,elt_type>) {
+          return branchless_lower_bound_position(range.data(),range.size(),x);
+        } else {
+          auto it = std::lower_bound(begin(range),end(range),x);
+          return it-begin(range);
+        }
       } else {
+        using elt_type = std::remove_cv_t<std::remove_reference_t<decltype(range[0])>>;
+        if constexpr (is_std_hashable<elt_type> && std::is_convertible_v<const T&,elt_type>) {
+          if (hash_indices[index]) {
+            auto& hash_index = *hash_indices[index];
+            hash_index.ensure_built(range);
+            const elt_type& key = x;
+            return hash_index.find(range,key);
+          }
+        }
         auto it = std::find(begin(range),end(range),x);
         return it-begin(range);
       }
@@ -124,6 +153,7 @@ class multi_range {
       //}
     }
 
+    /// Same hash index build as find_index
     template<int index, class T> constexpr auto
     // requires T==Ts[index]
     find(const T& x) const -> multi_elt_const_ref {
@@ -174,10 +204,52 @@ class multi_range {
       return get<found_index>(_impl)[i];
     }
 
+  // hash indices
+    template<int index> auto
+    enable_hash_index() -> void {
+      static_assert(index < nb_ranges());
+      static_assert(is_std_hashable<std::tuple_element_t<index,std::tuple<std::remove_cv_t<Ts>...>>>,"enable_hash_index: the range elements are not hashable");
+      if (!hash_indices[index]) {
+        hash_indices[index].emplace();
+      }
+    }
+    template<int index> auto
+    disable_hash_index() -> void {
+      static_assert(index < nb_ranges());
+      hash_indices[index].reset();
+    }
+    template<int index> auto
+    has_hash_index() const -> bool {
+      static_assert(index < nb_ranges());
+      return hash_indices[index].has_value();
+    }
+    /// Builds the hash index now instead of on the first find
+    template<int index> auto
+    build_hash_index() const -> void {
+      static_assert(index < nb_ranges());
+      STD_E_ASSERT(hash_indices[index]);
+      hash_indices[index]->ensure_built(get<index>(_impl));
+    }
+    template<int index> auto
+    invalidate_hash_index() -> void {
+      if (hash_indices[index]) {
+        hash_indices[index]->invalidate();
+      }
+    }
+    auto
+    invalidate_hash_indices() -> void {
+      for (auto& hash_index : hash_indices) {
+        if (hash_index) {
+          hash_index->invalidate();
+        }
+      }
+    }
+
   // vector-like interface
     template<class... Ts0> auto
     // requires Ts0 is Ts
     push_back(const Ts0&... elts) -> multi_elt_ref { // TODO how to enforce invariant (2) ?
+      invalidate_hash_indices();
       return push_back__impl(std::forward_as_tuple(elts...),std::make_index_sequence<nb_ranges()>());
     }
 
@@ -222,12 +294,15 @@ class multi_range {
     }
     template<class Int_range, size_t... Is> auto
     apply_permutation__impl(const Int_range& perm, std::index_sequence<Is...>) -> void {
-      ( std_e::permute(get<Is>(_impl),perm) , ... );
+      permutation_plan plan(perm); // cycles found once for all ranges
+      plan.apply(get<Is>(_impl)...);
+      invalidate_hash_indices();
     }
   // data members
   public:
     impl_type _impl;
     int sorted_rng_idx = -1; // no range sorted by default
+    mutable std::array<std::optional<column_hash_index>,sizeof...(Ts)> hash_indices; // built lazily by find, hence mutable
 };
 
 
@@ -359,6 +434,58 @@ find_associate(multi_range<RT,T0,T1>& x, const T1& value) -> T0& {
 
 template<class... Ts> using multi_vector = multi_range<std_alloc_vector,Ts...>;
 
+template<class T> using cache_aligned_vector = std::vector<T,aligned_allocator<T,64>>;
+/// each range starts on a cache line, so that the batches of `for_each_batch<N>` are aligned if N*sizeof(T) is a multiple of 64
+template<class... Ts> using aligned_multi_vector = multi_range<cache_aligned_vector,Ts...>;
+
+
+// batches {
+/**
+  for_each_batch<N>(x,f) iterates over the elements of multi_range `x` by batches of `N` consecutive indices
+  (the ranges must be contiguous, e.g. vectors or spans)
+  For each batch, f(n,ptrs...) is called, where `ptrs...` point to the first element of the batch in each range
+  and `n` is the number of elements of the batch:
+    - std::integral_constant<int,N> for the full batches, so that the loops `for (int i=0; i<n; ++i)` of `f`
+      have a compile-time trip count and are vectorized over the ranges
+    - an int smaller than `N` for the last batch, if any
+  for_each_batch<N,Is...>(x,f) is the same, with only ranges `Is...` passed to `f`
+  Example:
+      multi_vector<double,double,double> x = ...;
+      for_each_batch<8>(x,[](auto n, const double* a, const double* b, double* c){
+        for (int i=0; i<n; ++i) c[i] = a[i]*b[i];
+      });
+*/
+namespace detail {
+  template<int N, class F, class... Ptrs> auto
+  for_each_batch__impl(std::ptrdiff_t n, F& f, Ptrs... ptrs) -> void {
+    static_assert(N>0);
+    std::ptrdiff_t n_full = n - n%N;
+    for (std::ptrdiff_t i=0; i<n_full; i+=N) {
+      f(std::integral_constant<int,N>{},(ptrs+i)...);
+    }
+    if (n_full<n) {
+      f(int(n-n_full),(ptrs+n_full)...);
+    }
+  }
+  template<int N, class Multi_range, class F, int... Is> auto
+  for_each_batch__impl(Multi_range& x, F& f, std::integer_sequence<int,Is...>) -> void {
+    for_each_batch__impl<N>(x.size(),f,range<Is>(x).data()...);
+  }
+
+  template<int nb_ranges, int... Is> using batch_ranges =
+    std::conditional_t< sizeof...(Is)==0 , std::make_integer_sequence<int,nb_ranges> , std::integer_sequence<int,Is...> >;
+}
+
+template<int N, int... Is, template<class> class RT, class... Ts, class F> auto
+for_each_batch(const multi_range<RT,Ts...>& x, F&& f) -> void {
+  detail::for_each_batch__impl<N>(x,f,detail::batch_ranges<sizeof...(Ts),Is...>{});
+}
+template<int N, int... Is, template<class> class RT, class... Ts, class F> auto
+for_each_batch(multi_range<RT,Ts...>& x, F&& f) -> void {
+  detail::for_each_batch__impl<N>(x,f,detail::batch_ranges<sizeof...(Ts),Is...>{});
+}
+// batches }
+
 // multi_span {
 template<class... Ts> using multi_span = multi_range<dyn_span,Ts...>;
 
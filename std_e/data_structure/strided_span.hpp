@@ -5,6 +5,7 @@
 #include <type_traits>
 #include "std_e/base/dynamic_size.hpp"
 #include "std_e/base/macros.hpp"
+#include "std_e/future/algorithm.hpp"
 
 
 namespace std_e {
@@ -2,6 +2,7 @@
 #include "std_e/data_structure/multi_range.hpp"
 
 #include <string>
+#include <thread>
 
 // TODO RENAME cell->elt, row->multi_elt, col->range
 using std::vector;
@@ -215,3 +216,187 @@ TEST_CASE("make_span") {
     CHECK( col2 == expected_col2 );
   }
 }
+
+TEST_CASE("multi_vector find on a sorted range") {
+  std_e::multi_vector<int,double> t;
+  for (int i=0; i<100; ++i) {
+    t.push_back(3*(99-i),double(i));
+  }
+  std_e::sort_by<0>(t);
+
+  for (int i=0; i<100; ++i) {
+    CHECK( find_associate(t,3*i) == double(99-i) );
+  }
+  CHECK( t.find_index<0>(-1) == 0 );
+  CHECK( t.find_index<0>(4) == 2 ); // not found: position where it would be inserted
+  CHECK( t.find_index<0>(1000) == 100 );
+}
+
+TEST_CASE("multi_vector for_each_batch") {
+  int n = 19;
+  std_e::multi_vector<int,double,double> t;
+  for (int i=0; i<n; ++i) {
+    t.push_back(i,2.*i,0.);
+  }
+
+  SUBCASE("all ranges") {
+    std::vector<int> batch_sizes;
+    std::vector<int> batch_starts;
+    std_e::for_each_batch<8>(t,[&](auto n, int* is, double* a, double* b){
+      batch_sizes.push_back(n);
+      batch_starts.push_back(is[0]);
+      for (int i=0; i<n; ++i) {
+        b[i] = a[i]+is[i];
+      }
+    });
+    CHECK( batch_sizes  == std::vector{8,8,3} );
+    CHECK( batch_starts == std::vector{0,8,16} );
+    for (int i=0; i<n; ++i) {
+      CHECK( std_e::element<2>(t,i) == 3.*i );
+    }
+  }
+
+  SUBCASE("selected ranges") {
+    double s = 0.;
+    int n_full_batch = 0;
+    const auto& ct = t;
+    std_e::for_each_batch<4,1>(ct,[&](auto n, const double* a){
+      if constexpr (!std::is_same_v<decltype(n),int>) {
+        static_assert(decltype(n)::value==4);
+        ++n_full_batch;
+      }
+      for (int i=0; i<n; ++i) {
+        s += a[i];
+      }
+    });
+    CHECK( n_full_batch == 4 );
+    CHECK( s == 2.*(n*(n-1)/2) );
+  }
+
+  SUBCASE("empty") {
+    std_e::multi_vector<int,double> e;
+    int n_call = 0;
+    std_e::for_each_batch<8>(e,[&](auto, int*, double*){ ++n_call; });
+    CHECK( n_call == 0 );
+  }
+}
+
+TEST_CASE("aligned_multi_vector") {
+  std_e::aligned_multi_vector<int,double> t(10);
+  CHECK( reinterpret_cast<std::uintptr_t>(std_e::range<0>(t).data())%64 == 0 );
+  CHECK( reinterpret_cast<std::uintptr_t>(std_e::range<1>(t).data())%64 == 0 );
+}
+
+TEST_CASE("multi_vector hash index") {
+  std_e::multi_vector<int,std::string,double> t;
+  t.push_back(42,"X",3.14);
+  t.push_back(43,"Y",2.7);
+  t.push_back(0,"ABC",100.);
+  t.push_back(43,"Z",1.);
+
+  t.enable_hash_index<0>();
+  t.enable_hash_index<1>();
+  CHECK( t.has_hash_index<0>() );
+  CHECK( t.has_hash_index<1>() );
+  CHECK( !t.has_hash_index<2>() );
+
+  SUBCASE("find") {
+    CHECK( t.find_index<0>(42) == 0 );
+    CHECK( t.find_index<0>(43) == 1 ); // first occurrence
+    CHECK( t.find_index<0>(0) == 2 );
+    CHECK( t.find_index<0>(7) == 4 ); // not found
+    CHECK( t.find_index<1>("ABC") == 2 );
+    CHECK( t.find_index<1>("W") == 4 );
+    CHECK( std_e::find_element<1,2>(t,std::string("Z")) == 1. );
+  }
+
+  SUBCASE("invalidated by modifications") {
+    CHECK( t.find_index<0>(44) == 4 );
+
+    t.push_back(44,"W",0.);
+    CHECK( t.find_index<0>(44) == 4 );
+    CHECK( t.find_index<1>("W") == 4 );
+
+    std_e::range<0>(t)[0] = 45;
+    CHECK( t.find_index<0>(45) == 0 );
+    CHECK( t.find_index<0>(42) == 5 );
+
+    std_e::sort_by<2>(t); // 44,43,43,45,0
+    CHECK( t.find_index<0>(44) == 0 );
+    CHECK( t.find_index<0>(43) == 1 );
+    CHECK( t.find_index<1>("X") == 3 );
+
+    std::get<0>(t[1]) = 46; // element access: explicit invalidation
+    t.invalidate_hash_indices();
+    CHECK( t.find_index<0>(46) == 1 );
+    CHECK( t.find_index<0>(43) == 2 );
+  }
+
+  SUBCASE("disable") {
+    t.disable_hash_index<0>();
+    CHECK( !t.has_hash_index<0>() );
+    CHECK( t.find_index<0>(43) == 1 );
+  }
+}
+
+TEST_CASE("multi_vector hash index on many elements") {
+  int n = 10'000;
+  std_e::multi_vector<int,int> t;
+  for (int i=0; i<n; ++i) {
+    t.push_back(1024*((i*7919)%n),i); // keys with a power of 2 stride
+  }
+  t.enable_hash_index<0>();
+  t.build_hash_index<0>();
+  for (int i=0; i<n; ++i) {
+    CHECK( std_e::find_element<0,1>(t,1024*((i*7919)%n)) == i );
+  }
+  CHECK( t.find_index<0>(1) == n );
+}
+
+TEST_CASE("multi_vector hash index built by concurrent finds") {
+  int n = 10'000;
+  std_e::multi_vector<int,int> t;
+  for (int i=0; i<n; ++i) {
+    t.push_back(3*i,i);
+  }
+  t.enable_hash_index<0>();
+
+  const auto& ct = t;
+  int n_thread = 4;
+  std::vector<int> n_found(n_thread,0);
+  std::vector<std::thread> threads;
+  for (int k=0; k<n_thread; ++k) {
+    threads.emplace_back([&ct,&n_found,n,k](){
+      for (int i=0; i<n; ++i) {
+        n_found[k] += (ct.find_index<0>(3*i)==i);
+      }
+    });
+  }
+  for (auto& th : threads) th.join();
+
+  for (int k=0; k<n_thread; ++k) {
+    CHECK( n_found[k] == n );
+  }
+}
+
+TEST_CASE("column_hash_index move") {
+  std::vector<int> v = {42,43,0,43};
+  std_e::column_hash_index x;
+  x.build(v);
+
+  SUBCASE("ctor") {
+    std_e::column_hash_index y = std::move(x);
+    CHECK( y.is_built_for(4) );
+    CHECK( y.find(v,0) == 2 );
+    CHECK( !x.is_built_for(4) ); // the slots have been moved
+    x.ensure_built(v);
+    CHECK( x.find(v,43) == 1 );
+  }
+  SUBCASE("assignment") {
+    std_e::column_hash_index y;
+    y = std::move(x);
+    CHECK( y.is_built_for(4) );
+    CHECK( y.find(v,0) == 2 );
+    CHECK( !x.is_built_for(4) );
+  }
+}
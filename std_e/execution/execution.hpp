@@ -0,0 +1,96 @@
+#pragma once
+
+
+#include <thread>
+#include <future>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include "std_e/algorithm/distribution.hpp"
+
+
+namespace std_e {
+
+
+// execution policies {
+/**
+  Similar to the C++17 std::execution policies, except that
+    - they do not depend on a third-party library (libstdc++ parallel algorithms need TBB)
+    - the parallel policy carries its parameters:
+      - n_thread: maximum number of threads used by the algorithm (including the calling thread)
+      - grain_size: sub-problems smaller than this number of elements are solved sequentially
+*/
+inline auto
+default_n_thread() -> int {
+  int n = std::thread::hardware_concurrency();
+  return std::max(n,1);
+}
+
+struct sequential_policy {};
+
+struct parallel_policy {
+  int n_thread = default_n_thread();
+  std::ptrdiff_t grain_size = 1<<14;
+};
+
+inline constexpr sequential_policy seq = {};
+inline const parallel_policy par = {};
+
+template<class T> constexpr bool is_execution_policy =
+     std::is_same_v<std::decay_t<T>,sequential_policy>
+  || std::is_same_v<std::decay_t<T>,parallel_policy>;
+
+inline auto
+with_n_thread(parallel_policy pol, int n_thread) -> parallel_policy {
+  pol.n_thread = std::max(n_thread,1);
+  return pol;
+}
+
+/// number of chunks a range of `n` elements should be split into
+/// so that each thread gets at least `grain_size` elements
+template<class I> auto
+n_chunk(const parallel_policy& pol, I n) -> int {
+  I n_max = std::max(I(1),I(n/std::max(pol.grain_size,std::ptrdiff_t(1))));
+  return std::max(1,(int)std::min(I(pol.n_thread),n_max));
+}
+// execution policies }
+
+
+// fork-join primitives {
+/// Runs f0() on a new thread and f1() on the calling thread, then waits for both
+/// If f0 throws, the exception is rethrown on the calling thread
+template<class F0, class F1> auto
+fork_join(F0&& f0, F1&& f1) -> void {
+  auto f0_done = std::async(std::launch::async,std::forward<F0>(f0));
+  f1();
+  f0_done.get();
+}
+
+/// Splits [0,n) into `n_chk` contiguous chunks of (almost) equal size
+/// and calls f(i_chunk,chunk_start,chunk_finish) for each of them, each on its own thread
+template<class I, class F> auto
+for_each_chunk(int n_chk, I n, F f) -> void {
+  std::vector<I> chunk_bounds(n_chk+1);
+  uniform_distribution(begin(chunk_bounds),end(chunk_bounds),I(n));
+
+  std::vector<std::future<void>> chunks_done;
+  chunks_done.reserve(n_chk-1);
+  for (int i=1; i<n_chk; ++i) {
+    chunks_done.push_back(
+      std::async(std::launch::async,[&f,&chunk_bounds,i](){ f(i,chunk_bounds[i],chunk_bounds[i+1]); })
+    );
+  }
+  f(0,chunk_bounds[0],chunk_bounds[1]);
+  for (auto& chunk_done : chunks_done) {
+    chunk_done.get();
+  }
+}
+template<class I, class F> auto
+for_each_chunk(const parallel_policy& pol, I n, F f) -> void {
+  for_each_chunk(n_chunk(pol,n),n,f);
+}
+// fork-join primitives }
+
+
+} // std_e
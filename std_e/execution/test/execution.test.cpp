@@ -0,0 +1,38 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/execution/execution.hpp"
+#include <atomic>
+
+using namespace std_e;
+
+
+TEST_CASE("n_chunk") {
+  parallel_policy pol = {4,100};
+  CHECK( n_chunk(pol,  0) == 1 );
+  CHECK( n_chunk(pol, 99) == 1 );
+  CHECK( n_chunk(pol,250) == 2 );
+  CHECK( n_chunk(pol,1000) == 4 );
+}
+
+TEST_CASE("fork_join") {
+  int a = 0;
+  int b = 0;
+  fork_join(
+    [&a](){ a = 10; },
+    [&b](){ b = 20; }
+  );
+  CHECK( a == 10 );
+  CHECK( b == 20 );
+}
+
+TEST_CASE("for_each_chunk") {
+  std::vector<int> v(10);
+  std::atomic<int> n_call = 0;
+  for_each_chunk(3,10,[&](int i_chunk, int start, int finish){
+    ++n_call;
+    for (int i=start; i<finish; ++i) {
+      v[i] = i_chunk;
+    }
+  });
+  CHECK( n_call == 3 );
+  CHECK( v == std::vector{0,0,0,0, 1,1,1, 2,2,2} );
+}
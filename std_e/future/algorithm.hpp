@@ -7,6 +7,7 @@
 #include <utility>
 #include <iterator>
 #include <functional>
+#include "std_e/algorithm/simd_scan.hpp"
 
 
 namespace std_e {
@@ -334,10 +335,32 @@ count_if(InputIt first, InputIt last, UnaryPredicate p)
 }
 
 
+template<class InputIt, class OutputIt, class BinaryOperation, class T> constexpr auto
+inclusive_scan(InputIt first, InputIt last, OutputIt d_first, BinaryOperation op, T init) -> OutputIt {
+  if constexpr (use_simd_scan<InputIt,OutputIt,T,BinaryOperation>) {
+    if (!detail::is_constant_evaluated()) {
+      simd_scan<true>(first,last,d_first,init);
+      return d_first + (last-first);
+    }
+  }
+  while (first != last) {
+   init = op(std::move(init), *first++);
+   *d_first++ = init;
+  }
+  return d_first;
+}
 template<class InputIt, class OutputIt, class BinaryOperation> constexpr auto
 inclusive_scan(InputIt first, InputIt last, OutputIt d_first, BinaryOperation op) -> OutputIt {
   if (first == last) return d_first;
 
+  using T = std::remove_cv_t<typename std::iterator_traits<InputIt>::value_type>;
+  if constexpr (use_simd_scan<InputIt,OutputIt,T,BinaryOperation>) {
+    if (!detail::is_constant_evaluated()) {
+      simd_scan<true>(first,last,d_first,T(0));
+      return d_first + (last-first);
+    }
+  }
+
   auto sum = *first;
   *d_first = sum;
 
@@ -356,6 +379,13 @@ template<class InputIt, class OutputIt, class T, class BinaryOperation> constexp
 exclusive_scan(InputIt first, InputIt last, OutputIt d_first, T init, BinaryOperation op) -> OutputIt {
   if (first == last) return d_first;
 
+  if constexpr (use_simd_scan<InputIt,OutputIt,T,BinaryOperation>) {
+    if (!detail::is_constant_evaluated()) {
+      simd_scan<false>(first,last,d_first,init);
+      return d_first + (last-first);
+    }
+  }
+
   --last;
   *d_first = init;
 
@@ -370,5 +400,4 @@ exclusive_scan(InputIt first, InputIt last, OutputIt d_first, T init) -> OutputI
   return std_e::exclusive_scan(first, last, d_first, init, std::plus<>());
 }
 
-
 } // std_e
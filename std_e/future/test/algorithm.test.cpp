@@ -1,5 +1,7 @@
 #include "std_e/unit_test/doctest.hpp"
 #include "std_e/future/algorithm.hpp"
+#include <numeric>
+#include <vector>
 
 TEST_CASE("inclusive and exclusive scan") {
   std::vector<int> data = {3, 1, 4, 1, 5, 9, 2, 6};
@@ -16,3 +18,31 @@ TEST_CASE("inclusive and exclusive scan") {
   }
 }
 
+TEST_CASE("inclusive and exclusive scan of contiguous integers") { // SIMD version
+  for (int n=0; n<40; ++n) {
+    std::vector<long> data(n);
+    for (int i=0; i<n; ++i) data[i] = (i*7)%5 - 2;
+
+    std::vector<long> res(n);
+    std::vector<long> expected(n);
+
+    std_e::inclusive_scan(data.begin(), data.end(), res.begin());
+    std::inclusive_scan(data.begin(), data.end(), expected.begin());
+    CHECK( res == expected );
+
+    std_e::inclusive_scan(data.begin(), data.end(), res.begin(), std::plus<>(), 100L);
+    std::inclusive_scan(data.begin(), data.end(), expected.begin(), std::plus<>(), 100L);
+    CHECK( res == expected );
+
+    std_e::exclusive_scan(data.data(), data.data()+n, res.data(), 10L);
+    std::exclusive_scan(data.begin(), data.end(), expected.begin(), 10L);
+    CHECK( res == expected );
+
+    std::vector<unsigned> data_u(begin(data),end(data));
+    std::vector<unsigned> expected_u(n);
+    std::exclusive_scan(data_u.begin(), data_u.end(), expected_u.begin(), 1u);
+    std_e::exclusive_scan(data_u.begin(), data_u.end(), data_u.begin(), 1u); // in place
+    CHECK( data_u == expected_u );
+  }
+}
+
@@ -0,0 +1,64 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/graph/nested_tree/nested_tree.hpp"
+#include "std_e/graph/algorithm/algo_nodes.hpp"
+
+using namespace std_e;
+
+
+namespace {
+
+
+// balanced tree of `sz` nodes where each node has at most `n_child` children
+auto
+fill_balanced_tree(std::vector<int>& nodes, std::vector<int>& sizes, int pos, int sz, int n_child) -> void {
+  nodes[pos] = pos;
+  sizes[pos] = sz;
+  int remaining = sz-1;
+  int child_pos = pos+1;
+  for (int c=0; c<n_child && remaining>0; ++c) {
+    int child_sz = (remaining + (n_child-c) - 1) / (n_child-c);
+    fill_balanced_tree(nodes,sizes,child_pos,child_sz,n_child);
+    child_pos += child_sz;
+    remaining -= child_sz;
+  }
+}
+auto
+balanced_tree(int n, int n_child) -> nested_tree<int> {
+  std::vector<int> nodes(n);
+  std::vector<int> sizes(n);
+  fill_balanced_tree(nodes,sizes,0,n,n_child);
+  return {nodes,sizes};
+}
+
+
+STD_E_BENCHMARK("nested_tree/preorder_depth_first_scan", 1<<10, 1<<16, 1<<20) {
+  auto t = balanced_tree(state.size(),4);
+
+  long long s = 0;
+  state.run([&](){
+    preorder_depth_first_scan(t,[&s](int x){ s += x; });
+    do_not_optimize(s);
+  });
+}
+
+template<class Tree> auto
+recursive_sum(const Tree& t) -> long long {
+  long long s = root(t);
+  for (const auto& c : children(t)) {
+    s += recursive_sum(c);
+  }
+  return s;
+}
+
+STD_E_BENCHMARK("nested_tree/recursive_children_iteration", 1<<10, 1<<16, 1<<20) {
+  auto t = balanced_tree(state.size(),4);
+
+  long long s = 0;
+  state.run([&](){
+    s += recursive_sum(t);
+    do_not_optimize(s);
+  });
+}
+
+
+} // anonymous
@@ -5,6 +5,7 @@
 #include <vector>
 #include <numeric>
 #include "std_e/future/algorithm.hpp"
+#include "std_e/algorithm/parallel_scan.hpp"
 #include "std_e/future/contract.hpp"
 
 
@@ -197,6 +198,12 @@ indices_from_strides(const Random_access_range& r) -> interval_vector<T> {
   std_e::inclusive_scan(begin(r),end(r),begin(indices)+1);
   return indices;
 }
+template<class Random_access_range, class T = typename Random_access_range::value_type> auto
+indices_from_strides(const parallel_policy& pol, const Random_access_range& r) -> interval_vector<T> {
+  interval_vector<T> indices(r.size());
+  std_e::partial_accumulate(pol,begin(r),end(r),begin(indices),T(0));
+  return indices;
+}
 template<class Number, class Interval_sequence> auto
 interval_index(Number x, const Interval_sequence& is) {
   auto it = std::upper_bound(begin(is),end(is),x);
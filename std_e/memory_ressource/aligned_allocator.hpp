@@ -0,0 +1,55 @@
+#pragma once
+
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+
+namespace std_e {
+
+
+/// Same as std::allocator, but the memory is aligned on `Alignment` bytes
+/// The default, 64 bytes, is the size of a cache line and of an AVX-512 vector
+template<class T, std::size_t Alignment = 64>
+class aligned_allocator {
+  static_assert(Alignment>=alignof(T),"aligned_allocator: the alignment must be at least the one of T");
+  static_assert((Alignment & (Alignment-1))==0,"aligned_allocator: the alignment must be a power of 2");
+  public:
+    using value_type = T;
+    static constexpr std::size_t alignment = Alignment;
+
+    template<class U>
+    struct rebind {
+      using other = aligned_allocator<U,Alignment>;
+    };
+
+    aligned_allocator() = default;
+    template<class U> constexpr
+    aligned_allocator(const aligned_allocator<U,Alignment>&) noexcept
+    {}
+
+    auto
+    allocate(std::size_t n) -> T* {
+      return static_cast<T*>(::operator new(n*sizeof(T),std::align_val_t(Alignment)));
+    }
+    auto
+    deallocate(T* p, std::size_t) noexcept -> void {
+      ::operator delete(p,std::align_val_t(Alignment));
+    }
+};
+
+template<class T0, class T1, std::size_t A> constexpr auto
+operator==(const aligned_allocator<T0,A>&, const aligned_allocator<T1,A>&) -> bool {
+  return true; // no state
+}
+template<class T0, class T1, std::size_t A> constexpr auto
+operator!=(const aligned_allocator<T0,A>&, const aligned_allocator<T1,A>&) -> bool {
+  return false;
+}
+
+
+template<class T, std::size_t Alignment = 64> using aligned_vector = std::vector<T,aligned_allocator<T,Alignment>>;
+
+
+} // std_e
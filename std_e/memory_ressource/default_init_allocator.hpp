@@ -0,0 +1,47 @@
+#pragma once
+
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace std_e {
+
+
+/// Same as allocator `A`, except that value-initialization is replaced by default-initialization
+/// E.g. with std::vector<double,default_init_allocator<double>> v(n), the elements are not set to 0:
+/// the memory is not written, so the memory pages are not touched (see parallel_fill_copy.hpp for NUMA first touch)
+template<class T, class A = std::allocator<T>>
+class default_init_allocator : public A {
+  private:
+    using traits = std::allocator_traits<A>;
+  public:
+    template<class U>
+    struct rebind {
+      using other = default_init_allocator<U,typename traits::template rebind_alloc<U>>;
+    };
+
+    using A::A;
+    default_init_allocator() = default;
+    default_init_allocator(const A& a)
+      : A(a)
+    {}
+
+    template<class U> auto
+    construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>) -> void {
+      ::new(static_cast<void*>(p)) U;
+    }
+    template<class U, class... Args> auto
+    construct(U* p, Args&&... args) -> void {
+      traits::construct(static_cast<A&>(*this),p,std::forward<Args>(args)...);
+    }
+};
+
+
+template<class T, class A = std::allocator<T>> using default_init_vector = std::vector<T,default_init_allocator<T,A>>;
+
+
+} // std_e
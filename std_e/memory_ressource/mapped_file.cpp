@@ -0,0 +1,133 @@
+#include "std_e/memory_ressource/mapped_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace std_e {
+
+
+namespace {
+
+auto
+system_error_msg(const std::string& what, const std::string& file_name) -> std::string {
+  return "mapped_file: "+what+" \""+file_name+"\": "+std::strerror(errno);
+}
+
+auto
+to_madvise_flag(map_advice advice) -> int {
+  switch (advice) {
+    case map_advice::normal    : return MADV_NORMAL;
+    case map_advice::sequential: return MADV_SEQUENTIAL;
+    case map_advice::random    : return MADV_RANDOM;
+    case map_advice::will_need : return MADV_WILLNEED;
+  }
+  return MADV_NORMAL;
+}
+
+// closes the file descriptor at the end of the scope (the mapping stays valid after close)
+class file_descriptor {
+  public:
+    file_descriptor(int fd) : fd(fd) {}
+    file_descriptor(const file_descriptor&) = delete;
+    file_descriptor& operator=(const file_descriptor&) = delete;
+    ~file_descriptor() { if (fd>=0) ::close(fd); }
+    auto get() const -> int { return fd; }
+  private:
+    int fd;
+};
+
+} // anonymous
+
+
+mapped_file::
+mapped_file(const std::string& file_name, map_options opts)
+  : name(file_name)
+  , mod(opts.mode)
+{
+  bool rw = opts.mode==map_mode::read_write;
+  file_descriptor fd = ::open(file_name.c_str(), rw ? O_RDWR : O_RDONLY);
+  if (fd.get()<0) throw msg_exception(system_error_msg("can't open",file_name));
+
+  struct stat st;
+  if (::fstat(fd.get(),&st)!=0) throw msg_exception(system_error_msg("can't stat",file_name));
+  sz = st.st_size;
+  if (sz==0) return; // mmap of size 0 is an error: leave ptr null
+
+  int prot = rw ? PROT_READ|PROT_WRITE : PROT_READ;
+  int flags = MAP_SHARED;
+  #ifdef MAP_POPULATE
+    if (opts.populate) flags |= MAP_POPULATE;
+  #endif
+  void* p = ::mmap(nullptr,sz,prot,flags,fd.get(),0);
+  if (p==MAP_FAILED) throw msg_exception(system_error_msg("can't map",file_name));
+  ptr = static_cast<std::byte*>(p);
+
+  if (opts.advice!=map_advice::normal) advise(opts.advice);
+}
+
+mapped_file::
+mapped_file(mapped_file&& x) noexcept
+  : name(std::move(x.name))
+  , ptr(std::exchange(x.ptr,nullptr))
+  , sz(std::exchange(x.sz,0))
+  , mod(x.mod)
+{}
+
+auto mapped_file::
+operator=(mapped_file&& x) noexcept -> mapped_file& {
+  if (this!=&x) {
+    unmap();
+    name = std::move(x.name);
+    ptr = std::exchange(x.ptr,nullptr);
+    sz = std::exchange(x.sz,0);
+    mod = x.mod;
+  }
+  return *this;
+}
+
+mapped_file::
+~mapped_file() {
+  unmap();
+}
+
+auto mapped_file::
+unmap() noexcept -> void {
+  if (ptr!=nullptr) {
+    ::munmap(ptr,sz);
+    ptr = nullptr;
+    sz = 0;
+  }
+}
+
+auto mapped_file::
+advise(map_advice advice) -> void {
+  if (ptr==nullptr) return;
+  if (::madvise(ptr,sz,to_madvise_flag(advice))!=0) throw msg_exception(system_error_msg("madvise failed for",name));
+}
+
+auto mapped_file::
+sync() -> void {
+  if (ptr==nullptr || mod==map_mode::read_only) return;
+  if (::msync(ptr,sz,MS_SYNC)!=0) throw msg_exception(system_error_msg("msync failed for",name));
+}
+
+
+auto
+create_mapped_file(const std::string& file_name, std::size_t n_bytes, map_options opts) -> mapped_file {
+  {
+    file_descriptor fd = ::open(file_name.c_str(), O_RDWR|O_CREAT|O_TRUNC, 0644);
+    if (fd.get()<0) throw msg_exception(system_error_msg("can't create",file_name));
+    if (::ftruncate(fd.get(),n_bytes)!=0) throw msg_exception(system_error_msg("can't resize",file_name));
+  }
+  opts.mode = map_mode::read_write;
+  return mapped_file(file_name,opts);
+}
+
+
+} // std_e
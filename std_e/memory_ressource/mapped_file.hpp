@@ -0,0 +1,153 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include "std_e/memory_ressource/memory_ressource.hpp"
+#include "std_e/base/msg_exception.hpp"
+#include "std_e/future/contract.hpp"
+
+
+namespace std_e {
+
+
+// mapped_file {
+/**
+  A file mapped in memory (POSIX mmap)
+    - the mapping is shared (MAP_SHARED): writes go to the file,
+      and the memory is shared with the other processes mapping the same file
+    - the pages are only loaded when accessed, unless `populate` is set (MAP_POPULATE, Linux only)
+    - `advice` is passed to madvise
+  Errors are reported by throwing a msg_exception
+*/
+enum class map_mode { read_only, read_write };
+enum class map_advice { normal, sequential, random, will_need };
+
+struct map_options {
+  map_mode mode = map_mode::read_only;
+  map_advice advice = map_advice::normal;
+  bool populate = false;
+};
+
+class mapped_file {
+  public:
+  // ctors
+    mapped_file() = default;
+    /// maps the whole file
+    explicit mapped_file(const std::string& file_name, map_options opts = {});
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    mapped_file(mapped_file&& x) noexcept;
+    mapped_file& operator=(mapped_file&& x) noexcept;
+    ~mapped_file();
+
+  // accessors
+    auto data() const -> const std::byte* { return ptr; }
+    auto data()       ->       std::byte* { return ptr; }
+    /// in bytes
+    auto size() const -> std::size_t { return sz; }
+    auto mode() const -> map_mode { return mod; }
+    auto file_name() const -> const std::string& { return name; }
+
+  // memory hints and synchronization
+    auto advise(map_advice advice) -> void;
+    /// writes the modified pages to the file (msync), then returns
+    auto sync() -> void;
+  private:
+    auto unmap() noexcept -> void;
+
+    std::string name;
+    std::byte* ptr = nullptr;
+    std::size_t sz = 0;
+    map_mode mod = map_mode::read_only;
+};
+
+/// Creates (or truncates) file `file_name` with a size of `n_bytes`, and maps it in read-write mode
+auto create_mapped_file(const std::string& file_name, std::size_t n_bytes, map_options opts = {}) -> mapped_file;
+// mapped_file }
+
+
+// mapped_range {
+/**
+  Random access range of `T` over (part of) a mapped file
+  Copies are shallow: they refer to the same mapping, which stays alive until the last copy is destroyed
+  If the file is mapped read-only, `T` must be const
+  Note: `T` must be trivially copyable, since its bytes come directly from the file
+*/
+template<class T>
+class mapped_range {
+  static_assert(std::is_trivially_copyable_v<T>,"mapped_range: the elements are read from the file as bytes");
+  public:
+  // type traits
+    using value_type      = std::remove_cv_t<T>;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using iterator        = pointer;
+    using const_iterator  = const_pointer;
+
+  // ctors
+    mapped_range() = default;
+
+    /// elements of `f` starting at byte `offset`, until the end of the file
+    mapped_range(std::shared_ptr<mapped_file> f, std::size_t offset = 0)
+      : mapped_range(f,offset,f ? (f->size()-std::min(offset,f->size()))/sizeof(T) : 0)
+    {}
+    /// `n` elements of `f` starting at byte `offset`
+    mapped_range(std::shared_ptr<mapped_file> f, std::size_t offset, std::size_t n)
+      : f(std::move(f))
+      , n(n)
+    {
+      if (this->f==nullptr) {
+        STD_E_ASSERT(n==0);
+        return;
+      }
+      if (!std::is_const_v<T> && this->f->mode()==map_mode::read_only) {
+        throw msg_exception("mapped_range: file \""+this->f->file_name()+"\" is mapped read-only, the element type should be const");
+      }
+      if (offset%alignof(T)!=0) {
+        throw msg_exception("mapped_range: offset "+std::to_string(offset)+" is not aligned for the element type");
+      }
+      if (offset > this->f->size() || n > (this->f->size()-offset)/sizeof(T)) { // not offset+n*sizeof(T): may overflow
+        throw msg_exception(
+          "mapped_range: "+std::to_string(n)+" elements of "+std::to_string(sizeof(T))+" bytes from offset "+std::to_string(offset)
+         +" do not fit in file \""+this->f->file_name()+"\" of size "+std::to_string(this->f->size())
+        );
+      }
+      ptr = reinterpret_cast<T*>(this->f->data()+offset);
+    }
+
+  // range interface
+    auto size() const -> std::size_t { return n; }
+    auto data() const -> const_pointer { return ptr; }
+    auto data()       ->       pointer { return ptr; }
+    auto begin() const -> const_pointer { return ptr; }
+    auto begin()       ->       pointer { return ptr; }
+    auto end()   const -> const_pointer { return ptr+n; }
+    auto end()         ->       pointer { return ptr+n; }
+
+    template<class I> auto operator[](I i) const -> const_reference { return ptr[i]; }
+    template<class I> auto operator[](I i)       ->       reference { return ptr[i]; }
+
+  // mapping
+    auto file() const -> const std::shared_ptr<mapped_file>& { return f; }
+  private:
+    std::shared_ptr<mapped_file> f;
+    T* ptr = nullptr;
+    std::size_t n = 0;
+};
+
+/// copies of a mapped_range are shallow, as for a span
+template<class T>
+struct memory_is_owned__impl<mapped_range<T>> {
+  static constexpr bool value = false;
+};
+// mapped_range }
+
+
+} // std_e
@@ -0,0 +1,106 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/memory_ressource/mapped_file.hpp"
+#include "std_e/multi_array/multi_array/mapped_multi_array.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <unistd.h>
+
+using namespace std_e;
+
+
+namespace {
+
+auto
+temporary_file_name(const std::string& name) -> std::string {
+  return (std::filesystem::temp_directory_path() / (name+"_"+std::to_string(::getpid()))).string();
+}
+
+} // anonymous
+
+
+TEST_CASE("mapped_file") {
+  std::string file_name = temporary_file_name("std_e_mapped_file_test");
+  {
+    std::vector<int> v = {0,1,2,3,4,5};
+    std::ofstream out(file_name,std::ios::binary);
+    out.write(reinterpret_cast<const char*>(v.data()),v.size()*sizeof(int));
+  }
+
+  SUBCASE("read-only") {
+    auto f = std::make_shared<mapped_file>(file_name,map_options{map_mode::read_only,map_advice::sequential,true});
+    CHECK( f->size() == 6*sizeof(int) );
+
+    mapped_range<const int> r(f);
+    CHECK( r.size() == 6 );
+    CHECK( std::vector<int>(r.begin(),r.end()) == std::vector{0,1,2,3,4,5} );
+
+    mapped_range<const int> r_sub(f,2*sizeof(int),3);
+    CHECK( std::vector<int>(r_sub.begin(),r_sub.end()) == std::vector{2,3,4} );
+
+    CHECK_THROWS_AS( mapped_range<int>(f) , msg_exception ); // not const
+    CHECK_THROWS_AS( mapped_range<const int>(f,2*sizeof(int),5) , msg_exception ); // too big
+    CHECK_THROWS_AS( mapped_range<const int>(f,0,std::size_t(-1)/sizeof(int)+1) , msg_exception ); // n*sizeof(T) overflows
+    CHECK_THROWS_AS( mapped_range<const int>(f,std::size_t(-1)-sizeof(int)+1,1) , msg_exception ); // offset+sizeof(T) overflows
+  }
+  SUBCASE("read-write, shared between mappings") {
+    auto f0 = std::make_shared<mapped_file>(file_name,map_options{map_mode::read_write});
+    auto f1 = std::make_shared<mapped_file>(file_name);
+    mapped_range<int> r0(f0);
+    mapped_range<const int> r1(f1);
+
+    r0[4] = 40;
+    CHECK( r1[4] == 40 );
+
+    f0->sync();
+    std::ifstream in(file_name,std::ios::binary);
+    std::vector<int> v(6);
+    in.read(reinterpret_cast<char*>(v.data()),v.size()*sizeof(int));
+    CHECK( v == std::vector{0,1,2,3,40,5} );
+  }
+  SUBCASE("errors") {
+    CHECK_THROWS_AS( mapped_file(file_name+"_does_not_exist") , msg_exception );
+  }
+
+  std::remove(file_name.c_str());
+}
+
+TEST_CASE("mapped_multi_array") {
+  std::string file_name = temporary_file_name("std_e_mapped_multi_array_test");
+
+  {
+    auto x = create_mapped_multi_array<double>(file_name,multi_index<int,2>{3,2});
+    CHECK( x.extent() == multi_index<int,2>{3,2} );
+    for (int j=0; j<2; ++j) {
+      for (int i=0; i<3; ++i) {
+        x(i,j) = i+10*j;
+      }
+    }
+    auto x_copy = x; // shallow
+    x_copy(2,1) = 100.;
+    CHECK( x(2,1) == 100. );
+  } // unmapped
+
+  CHECK( std::filesystem::file_size(file_name) == 6*sizeof(double) );
+  auto y = make_mapped_multi_array<const double>(file_name,multi_index<int,2>{3,2});
+  CHECK( y(1,0) == 1. );
+  CHECK( y(0,1) == 10. );
+  CHECK( y(2,1) == 100. );
+
+  auto col_1 = make_mapped_multi_array<const double>(file_name,multi_index<int>{3},{},3*sizeof(double)); // second column
+  CHECK( col_1(0) == 10. );
+  CHECK( col_1(1) == 11. );
+  CHECK( col_1(2) == 100. );
+
+  CHECK_THROWS_AS( make_mapped_multi_array<const double>(file_name,multi_index<int,2>{3,3}) , msg_exception );
+
+  auto z = make_mapped_multi_array<double>(file_name,multi_index<int,2>{3,2}); // read-write by default
+  z(0,0) = -1.;
+  CHECK( y(0,0) == -1. );
+  map_options read_only;
+  read_only.mode = map_mode::read_only;
+  CHECK_THROWS_AS( make_mapped_multi_array<double>(file_name,multi_index<int,2>{3,2},read_only) , msg_exception );
+
+  std::remove(file_name.c_str());
+}
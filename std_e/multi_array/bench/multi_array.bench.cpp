@@ -0,0 +1,440 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/multi_array/multi_array.hpp"
+#include "std_e/multi_array/multi_array/transpose.hpp"
+#include "std_e/multi_array/multi_array/expression.hpp"
+#include "std_e/multi_array/multi_array/contiguous_runs.hpp"
+#include "std_e/multi_index/parallel_for.hpp"
+#include "std_e/multi_index/for_each_multi_index.hpp"
+#include "std_e/multi_array/multi_array/reduction.hpp"
+#include <cmath>
+#include <numeric>
+
+using namespace std_e;
+
+
+namespace {
+
+
+auto
+cube_side(std::int64_t n) -> int {
+  return std::lround(std::cbrt(double(n)));
+}
+
+
+STD_E_BENCHMARK("multi_array/dyn_rank3/element_access", 1<<12, 1<<15, 1<<18, 1<<21) {
+  int m = cube_side(state.size());
+  dyn_multi_array<double,3> x(m,m,m);
+  std::fill(begin(x),end(x),1.);
+  state.set_items_processed(x.size());
+
+  double s = 0.;
+  state.run([&](){
+    for (int k=0; k<m; ++k) {
+      for (int j=0; j<m; ++j) {
+        for (int i=0; i<m; ++i) {
+          s += x(i,j,k);
+        }
+      }
+    }
+    do_not_optimize(s);
+  });
+}
+
+STD_E_BENCHMARK("multi_array/dyn_rank3/element_write", 1<<12, 1<<15, 1<<18, 1<<21) {
+  int m = cube_side(state.size());
+  dyn_multi_array<double,3> x(m,m,m);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    for (int k=0; k<m; ++k) {
+      for (int j=0; j<m; ++j) {
+        for (int i=0; i<m; ++i) {
+          x(i,j,k) = i+j+k;
+        }
+      }
+    }
+    do_not_optimize(x);
+  });
+}
+
+STD_E_BENCHMARK("multi_array/dyn_rank/element_access", 1<<12, 1<<15, 1<<18, 1<<21) {
+  int m = cube_side(state.size());
+  dyn_multi_array<double,dynamic_size> x(m,m,m);
+  std::fill(begin(x),end(x),1.);
+  state.set_items_processed(x.size());
+
+  double s = 0.;
+  state.run([&](){
+    for (int k=0; k<m; ++k) {
+      for (int j=0; j<m; ++j) {
+        for (int i=0; i<m; ++i) {
+          s += x(i,j,k);
+        }
+      }
+    }
+    do_not_optimize(s);
+  });
+}
+
+STD_E_BENCHMARK("multi_array/dyn_rank/linear_indices", 1<<12, 1<<15, 1<<18, 1<<21) {
+  int n = state.size();
+  dyn_shape<int,dynamic_size> sh = {{64,64,64,64},{1,2,3,4}};
+  std::vector<int> indices_by_dim(4*n);
+  for (int i=0; i<4*n; ++i) {
+    indices_by_dim[i] = (i*7)%64;
+  }
+  std::vector<int> res(n);
+  state.set_items_processed(n);
+
+  state.run([&](){
+    linear_indices(sh,indices_by_dim.data(),n,res.data());
+    do_not_optimize(res);
+  });
+}
+
+STD_E_BENCHMARK("multi_array/dyn_rank/linear_index_loop", 1<<12, 1<<15, 1<<18, 1<<21) {
+  int n = state.size();
+  dyn_shape<int,dynamic_size> sh = {{64,64,64,64},{1,2,3,4}};
+  std::vector<int> indices_by_dim(4*n);
+  for (int i=0; i<4*n; ++i) {
+    indices_by_dim[i] = (i*7)%64;
+  }
+  std::vector<int> res(n);
+  state.set_items_processed(n);
+
+  state.run([&](){
+    multi_index<int> is(4);
+    for (int j=0; j<n; ++j) {
+      for (int k=0; k<4; ++k) is[k] = indices_by_dim[k*n+j];
+      res[j] = fortran_order_from_dimensions(sh.extent(),sh.offset(),is);
+    }
+    do_not_optimize(res);
+  });
+}
+
+STD_E_BENCHMARK("multi_array/fixed_3x3/element_access", 1<<10, 1<<14, 1<<18) {
+  std::int64_t n = state.size();
+  std::vector<fixed_multi_array<double,3,3>> xs(n);
+  for (auto& x : xs) {
+    std::fill(begin(x),end(x),1.);
+  }
+
+  double s = 0.;
+  state.run([&](){
+    for (const auto& x : xs) {
+      for (int j=0; j<3; ++j) {
+        for (int i=0; i<3; ++i) {
+          s += x(i,j);
+        }
+      }
+    }
+    do_not_optimize(s);
+  });
+}
+
+
+auto
+square_side(std::int64_t n) -> int {
+  return std::lround(std::sqrt(double(n)));
+}
+
+STD_E_BENCHMARK("multi_array/transpose/naive", 1<<12, 1<<16, 1<<20, 1<<22) {
+  int m = square_side(state.size());
+  dyn_multi_array<float,2> x(m,m);
+  dyn_multi_array<float,2> y(m,m);
+  std::iota(begin(x),end(x),0.f);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    for (int j=0; j<m; ++j) {
+      for (int i=0; i<m; ++i) {
+        y(i,j) = x(j,i);
+      }
+    }
+    do_not_optimize(y);
+  });
+}
+
+STD_E_BENCHMARK("multi_array/transpose/tiled", 1<<12, 1<<16, 1<<20, 1<<22) {
+  int m = square_side(state.size());
+  dyn_multi_array<float,2> x(m,m);
+  dyn_multi_array<float,2> y(m,m);
+  std::iota(begin(x),end(x),0.f);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    transpose_copy(x,y);
+    do_not_optimize(y);
+  });
+}
+
+STD_E_BENCHMARK("multi_array/transpose/tiled_par", 1<<12, 1<<16, 1<<20, 1<<22) {
+  int m = square_side(state.size());
+  dyn_multi_array<float,2> x(m,m);
+  dyn_multi_array<float,2> y(m,m);
+  std::iota(begin(x),end(x),0.f);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    transpose_copy(par,x,y);
+    do_not_optimize(y);
+  });
+}
+
+STD_E_BENCHMARK("multi_array/permute_axes_copy/rank4", 1<<12, 1<<16, 1<<20) {
+  int m = std::lround(std::sqrt(std::sqrt(double(state.size()))));
+  dyn_multi_array<double,4> x(m,m,m,m);
+  dyn_multi_array<double,4> y(m,m,m,m);
+  std::iota(begin(x),end(x),0.);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    permute_axes_copy(x,y,multi_index<int,4>{3,1,0,2});
+    do_not_optimize(y);
+  });
+}
+
+
+STD_E_BENCHMARK("multi_array/expression/hand_written_loop", 1<<12, 1<<16, 1<<20) {
+  int m = square_side(state.size());
+  dyn_multi_array<double,2> a(m,m), b(m,m), c(m,m), d(m,m);
+  std::iota(begin(b),end(b),0.);
+  std::iota(begin(c),end(c),1.);
+  std::iota(begin(d),end(d),2.);
+  state.set_items_processed(a.size());
+
+  state.run([&](){
+    for (int j=0; j<m; ++j) {
+      for (int i=0; i<m; ++i) {
+        a(i,j) = b(i,j)*c(i,j) + d(i,j);
+      }
+    }
+    do_not_optimize(a);
+  });
+}
+
+STD_E_BENCHMARK("multi_array/expression/fused", 1<<12, 1<<16, 1<<20) {
+  int m = square_side(state.size());
+  dyn_multi_array<double,2> a(m,m), b(m,m), c(m,m), d(m,m);
+  std::iota(begin(b),end(b),0.);
+  std::iota(begin(c),end(c),1.);
+  std::iota(begin(d),end(d),2.);
+  state.set_items_processed(a.size());
+
+  state.run([&](){
+    a = b*c + d;
+    do_not_optimize(a);
+  });
+}
+
+
+template<class Multi_array> auto
+stencil_bench(benchmark_state& state) -> void {
+  int m = square_side(state.size());
+  Multi_array x(m,m);
+  Multi_array y(m,m);
+  for (int j=0; j<m; ++j) {
+    for (int i=0; i<m; ++i) {
+      x(i,j) = i+j;
+    }
+  }
+  state.set_items_processed(std::int64_t(m-2)*(m-2));
+
+  state.run([&](){
+    for (int j=1; j<m-1; ++j) {
+      const double* RESTRICT xc = &x(0,j);
+      const double* RESTRICT xl = &x(0,j-1);
+      const double* RESTRICT xr = &x(0,j+1);
+      double* RESTRICT yc = &y(0,j);
+      for (int i=1; i<m-1; ++i) {
+        yc[i] = 4*xc[i] - xc[i-1] - xc[i+1] - xl[i] - xr[i];
+      }
+    }
+    do_not_optimize(y);
+  });
+}
+STD_E_BENCHMARK("multi_array/stencil/dyn_multi_array", 1<<12, 1<<16, 1<<20) {
+  stencil_bench<dyn_multi_array<double,2>>(state);
+}
+STD_E_BENCHMARK("multi_array/stencil/padded_multi_array", 1<<12, 1<<16, 1<<20) {
+  stencil_bench<padded_multi_array<double,2>>(state);
+}
+
+
+// block copy: the block is the interior of a (m+2)x(m+2) array
+STD_E_BENCHMARK("multi_array/block_copy/element_wise", 1<<12, 1<<16, 1<<20) {
+  int m = square_side(state.size());
+  dyn_multi_array<double,2> x(m+2,m+2);
+  dyn_multi_array<double,2> y(m+2,m+2);
+  std::iota(begin(x),end(x),0.);
+  auto src = make_block_view(x,multi_index<int,2>{1,1},multi_index<int,2>{m,m});
+  auto dst = make_block_view(y,multi_index<int,2>{1,1},multi_index<int,2>{m,m});
+  state.set_items_processed(std::int64_t(m)*m);
+
+  state.run([&](){
+    for (int j=0; j<m; ++j) {
+      for (int i=0; i<m; ++i) {
+        dst(i,j) = src(i,j);
+      }
+    }
+    do_not_optimize(y);
+  });
+}
+STD_E_BENCHMARK("multi_array/block_copy/contiguous_runs", 1<<12, 1<<16, 1<<20) {
+  int m = square_side(state.size());
+  dyn_multi_array<double,2> x(m+2,m+2);
+  dyn_multi_array<double,2> y(m+2,m+2);
+  std::iota(begin(x),end(x),0.);
+  auto src = make_block_view(x,multi_index<int,2>{1,1},multi_index<int,2>{m,m});
+  auto dst = make_block_view(y,multi_index<int,2>{1,1},multi_index<int,2>{m,m});
+  state.set_items_processed(std::int64_t(m)*m);
+
+  state.run([&](){
+    copy(src,dst);
+    do_not_optimize(y);
+  });
+}
+
+
+// rank 3 sweeps: x(is) = is[0]+is[1]+is[2] {
+template<class Multi_index> auto
+sweep_extent(int m) -> Multi_index {
+  auto extent = make_array_of_size<Multi_index>(3);
+  std::fill(begin(extent),end(extent),m);
+  return extent;
+}
+
+template<class Multi_index> auto
+sweep_multi_index_range_bench(benchmark_state& state) -> void {
+  int m = cube_side(state.size());
+  dyn_multi_array<double,3> x(m,m,m);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    for (const auto& is : fortran_multi_index_range(sweep_extent<Multi_index>(m))) {
+      x(is) = is[0]+is[1]+is[2];
+    }
+    do_not_optimize(x);
+  });
+}
+template<class Multi_index, class Policy> auto
+sweep_parallel_for_bench(benchmark_state& state, const Policy& pol) -> void {
+  int m = cube_side(state.size());
+  dyn_multi_array<double,3> x(m,m,m);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    parallel_for(pol,sweep_extent<Multi_index>(m),[&x](const auto& is){ x(is) = is[0]+is[1]+is[2]; });
+    do_not_optimize(x);
+  });
+}
+STD_E_BENCHMARK("multi_array/sweep/multi_index_range", 1<<12, 1<<15, 1<<18, 1<<21) {
+  sweep_multi_index_range_bench<multi_index<int,3>>(state);
+}
+STD_E_BENCHMARK("multi_array/sweep/multi_index_range_dyn_rank", 1<<12, 1<<15, 1<<18, 1<<21) {
+  sweep_multi_index_range_bench<multi_index<int>>(state);
+}
+STD_E_BENCHMARK("multi_array/sweep/parallel_for_seq", 1<<12, 1<<15, 1<<18, 1<<21) {
+  sweep_parallel_for_bench<multi_index<int,3>>(state,seq);
+}
+STD_E_BENCHMARK("multi_array/sweep/parallel_for_seq_dyn_rank", 1<<12, 1<<15, 1<<18, 1<<21) {
+  sweep_parallel_for_bench<multi_index<int>>(state,seq);
+}
+STD_E_BENCHMARK("multi_array/sweep/parallel_for_par", 1<<12, 1<<15, 1<<18, 1<<21) {
+  sweep_parallel_for_bench<multi_index<int,3>>(state,par);
+}
+// rank 3 sweeps }
+
+
+// fixed 16x16x16 sweeps {
+using fixed_cube = fixed_multi_array<double,16,16,16>;
+
+STD_E_BENCHMARK("multi_array/fixed_sweep/multi_index_range", 1<<12) {
+  fixed_cube x;
+  state.set_items_processed(x.size());
+  state.run([&](){
+    for (const auto& is : fortran_multi_index_range(x.extent())) {
+      x(is) = is[0]+is[1]+is[2];
+    }
+    do_not_optimize(x);
+  });
+}
+STD_E_BENCHMARK("multi_array/fixed_sweep/for_each_multi_index", 1<<12) {
+  fixed_cube x;
+  state.set_items_processed(x.size());
+  state.run([&](){
+    for_each_multi_index(x.extent(),[&x](const auto& is){ x(is) = is[0]+is[1]+is[2]; });
+    do_not_optimize(x);
+  });
+}
+STD_E_BENCHMARK("multi_array/fixed_sweep/for_each_multi_index_ct_extent", 1<<12) {
+  fixed_cube x;
+  state.set_items_processed(x.size());
+  state.run([&](){
+    for_each_multi_index<16,16,16>([&x](const auto& is){ x(is) = is[0]+is[1]+is[2]; });
+    do_not_optimize(x);
+  });
+}
+// fixed 16x16x16 sweeps }
+
+
+// reductions {
+STD_E_BENCHMARK("multi_array/sum/hand_written_loop", 1<<12, 1<<16, 1<<20) {
+  int m = square_side(state.size());
+  dyn_multi_array<float,2> x(m,m);
+  std::iota(begin(x),end(x),0.f);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    float s = 0.f;
+    for (int j=0; j<m; ++j) {
+      for (int i=0; i<m; ++i) {
+        s += x(i,j);
+      }
+    }
+    do_not_optimize(s);
+  });
+}
+STD_E_BENCHMARK("multi_array/sum/reduction", 1<<12, 1<<16, 1<<20) {
+  int m = square_side(state.size());
+  dyn_multi_array<float,2> x(m,m);
+  std::iota(begin(x),end(x),0.f);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    float s = sum(x);
+    do_not_optimize(s);
+  });
+}
+STD_E_BENCHMARK("multi_array/sum_axis_1/hand_written_loop", 1<<12, 1<<16, 1<<20) {
+  int m = square_side(state.size());
+  dyn_multi_array<float,2> x(m,m);
+  std::iota(begin(x),end(x),0.f);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    dyn_multi_array<float,1> s(m);
+    for (int i=0; i<m; ++i) {
+      s(i) = 0.f;
+      for (int j=0; j<m; ++j) {
+        s(i) += x(i,j);
+      }
+    }
+    do_not_optimize(s);
+  });
+}
+STD_E_BENCHMARK("multi_array/sum_axis_1/reduction", 1<<12, 1<<16, 1<<20) {
+  int m = square_side(state.size());
+  dyn_multi_array<float,2> x(m,m);
+  std::iota(begin(x),end(x),0.f);
+  state.set_items_processed(x.size());
+
+  state.run([&](){
+    auto s = sum_axis(x,1);
+    do_not_optimize(s);
+  });
+}
+// reductions }
+
+
+} // anonymous
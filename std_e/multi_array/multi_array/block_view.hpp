@@ -17,6 +17,7 @@ class block_view {
     static constexpr int ct_rank = std::decay_t<Multi_array_type>::ct_rank;
     using multi_index_type = typename std::decay_t<Multi_array_type>::multi_index_type;
     using index_type = typename std::decay_t<Multi_array_type>::index_type;
+    using origin_layout_type = typename std::decay_t<Multi_array_type>::shape_type::layout_type;
 
     using value_type = add_other_type_constness<typename std::decay_t<Multi_array_type>::value_type,std::remove_reference_t<Multi_array_type>>;
     using T = value_type;
@@ -27,15 +28,11 @@ class block_view {
 
   // ctors
     template<class Multi_array_type_0>
-    block_view(Multi_array_type_0&& x, multi_index_type offset, multi_index_type dims)
+    block_view(Multi_array_type_0&& x, const multi_index_type& offset, multi_index_type dims)
       : origin_ma(FWD(x))
-      , total_offset(std::move(offset))
+      , block_start(origin_ma.shape().linear_index(offset))
       , dims(std::move(dims))
-    {
-      for (int i=0; i<rank(); ++i) {
-        total_offset[i] += origin_ma.offset(i);
-      }
-    }
+    {}
 
     template<class Multi_array_type_0, class I0>
     block_view(Multi_array_type_0&& x, const multi_interval<I0>& sub_interval)
@@ -73,6 +70,29 @@ class block_view {
       return cartesian_product_size(extent());
     }
 
+  // memory
+    // Same meaning as for multi_array: element `is` is at data()[base_offset() + sum_k is[k]*strides(k)]
+    FORCE_INLINE constexpr auto
+    data() const -> const_pointer {
+      return origin_ma.data();
+    }
+    FORCE_INLINE constexpr auto
+    data() -> pointer {
+      return origin_ma.data();
+    }
+    FORCE_INLINE constexpr auto
+    strides() const -> decltype(auto) {
+      return origin_ma.strides();
+    }
+    FORCE_INLINE constexpr auto
+    strides(int i) const -> index_type {
+      return origin_ma.strides(i);
+    }
+    FORCE_INLINE constexpr auto
+    base_offset() const -> index_type {
+      return block_start;
+    }
+
   // element access
     template<class... Ts> FORCE_INLINE constexpr auto
     operator()(Ts&&... xs) const -> const_reference {
@@ -100,7 +120,7 @@ class block_view {
     FORCE_INLINE constexpr auto
     linear_index(const MI& indices) const -> index_type {
       STD_E_ASSERT((int)indices.size()==rank());
-      return fortran_order_from_dimensions(origin_ma.extent(),total_offset,indices);
+      return origin_layout_type::linear_index(origin_ma.strides(),block_start,indices);
     }
     /// from indices
     template<
@@ -125,7 +145,7 @@ class block_view {
 
 // data members
     remove_rvalue_reference<Multi_array_type> origin_ma;
-    multi_index_type total_offset;
+    index_type block_start; // linear index of the first element of the block
     multi_index_type dims;
 };
 
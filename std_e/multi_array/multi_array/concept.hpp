@@ -3,6 +3,7 @@
 
 #include "std_e/multi_index/concept.hpp"
 #include "std_e/multi_array/shape/concept.hpp"
+#include <type_traits>
 
 
 namespace std_e {
@@ -36,4 +37,10 @@ concept Multi_array {
 */
 
 
+/// Base class of the lazy element-wise expressions (see multi_array/expression.hpp)
+struct multi_array_expression_base {};
+
+template<class T> constexpr bool is_multi_array_expression = std::is_base_of_v<multi_array_expression_base,std::decay_t<T>>;
+
+
 } // std_e
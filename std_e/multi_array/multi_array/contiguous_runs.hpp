@@ -0,0 +1,130 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "std_e/future/span.hpp"
+#include "std_e/multi_array/multi_array/multi_array.hpp"
+#include "std_e/multi_array/multi_array/block_view.hpp"
+#include "std_e/multi_array/multi_array/strided_array.hpp"
+#include "std_e/multi_array/multi_array/transpose.hpp"
+
+
+namespace std_e {
+
+
+/**
+  Contiguous runs of the elements of multi_arrays and of their views (block_view, strided_array)
+  Accessing the elements of a view one by one goes through the multi-index to linear index mapping of its origin array.
+  Here, only the extent, the strides and the first element are used, and the elements are grouped by runs
+  that are contiguous in memory: the dimensions following each other in memory are merged, so that
+    - a (non-padded) multi_array is one run
+    - a block_view of a Fortran-ordered array has one run by column of the block
+      (or one run if the block has whole columns)
+    - a strided_array fixing the first index of a Fortran-ordered array has runs of size 1
+  Then, fill, copy and assign work on whole runs (std::fill_n and std::copy_n, i.e. memset and memcpy for trivial types)
+*/
+
+
+// multi_array-like {
+template<class T> struct is_multi_array_like__impl : std::false_type {};
+template<class R, class S>
+struct is_multi_array_like__impl<multi_array<R,S>> : std::true_type {};
+template<class M>
+struct is_multi_array_like__impl<block_view<M>> : std::true_type {};
+template<class M, class S, class MI>
+struct is_multi_array_like__impl<strided_array<M,S,MI>> : std::true_type {};
+
+/// multi_array, block_view or strided_array:
+/// element `is` is at x.data()[x.base_offset() + sum_k is[k]*x.strides(k)]
+template<class T> constexpr bool is_multi_array_like = is_multi_array_like__impl<std::decay_t<T>>::value;
+// multi_array-like }
+
+
+namespace detail {
+  template<class Multi_array> auto
+  extent_and_strides(const Multi_array& x) {
+    int rank = x.rank();
+    std::vector<std::ptrdiff_t> extent(rank);
+    std::vector<std::ptrdiff_t> strides(rank);
+    for (int k=0; k<rank; ++k) {
+      extent[k] = x.extent(k);
+      strides[k] = x.strides(k);
+    }
+    return std::make_pair(std::move(extent),std::move(strides));
+  }
+}
+
+
+namespace detail {
+  /// Calls `f(ptr,run_size)` for each contiguous run of the elements at `first + sum_k is[k]*strides[k]`, for `is` in [0,extent)
+  /// Precondition: `extent` and `strides` are given by `merge_contiguous_dims` (see transpose.hpp)
+  template<class T, class F> auto
+  for_each_run(T* first, const std::vector<std::ptrdiff_t>& extent, const std::vector<std::ptrdiff_t>& strides, F&& f) -> void {
+    using I = std::ptrdiff_t;
+    T* ptr = first;
+    int rank = extent.size();
+    if (rank==0) {
+      return f(ptr,I(1));
+    }
+
+    bool first_dim_is_contiguous = strides[0]==1;
+    I run_size = first_dim_is_contiguous ? extent[0] : 1;
+    int first_outer = first_dim_is_contiguous ? 1 : 0;
+    int n_outer = rank-first_outer;
+
+    std::vector<I> is(n_outer,0);
+    while (true) {
+      f(ptr,run_size);
+      int k = 0;
+      for (; k<n_outer; ++k) {
+        int dim = first_outer+k;
+        ++is[k];
+        ptr += strides[dim];
+        if (is[k]<extent[dim]) break;
+        ptr -= extent[dim]*strides[dim];
+        is[k] = 0;
+      }
+      if (k==n_outer) return;
+    }
+  }
+}
+
+
+/// Calls `f(run)` for each maximal contiguous run of elements of `x`, where `run` is a `span`
+/// The runs are in the memory order of `x`
+template<class Multi_array, class F, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto
+for_each_contiguous_run(Multi_array&& x, F f) -> void {
+  auto [extent,strides] = detail::extent_and_strides(x);
+  auto strides_copy = strides;
+  if (!detail::merge_contiguous_dims(extent,strides,strides_copy)) return;
+
+  detail::for_each_run(x.data()+x.base_offset(),extent,strides,[&f](auto* ptr, std::ptrdiff_t n){ f(make_span(ptr,n)); });
+}
+
+
+/// x(is) = value for all `is`
+template<class Multi_array, class T, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto
+fill(Multi_array&& x, const T& value) -> void {
+  for_each_contiguous_run(x,[&value](auto run){ std::fill_n(run.data(),run.size(),value); });
+}
+
+/// dst(is) = src(is) for all `is`
+/// Precondition: same extent
+/// Note: if the two arrays do not have the same contiguous dimension, the copy is done by tiles (see transpose.hpp)
+template<class Multi_array_0, class Multi_array_1,
+  std::enable_if_t< is_multi_array_like<Multi_array_0> && is_multi_array_like<Multi_array_1> , int > =0
+> auto
+copy(const Multi_array_0& src, Multi_array_1&& dst) -> void {
+  auto [extent,src_strides] = detail::extent_and_strides(src);
+  auto dst_strides = detail::extent_and_strides(dst).second;
+  for (int k=0; k<(int)extent.size(); ++k) {
+    STD_E_ASSERT(extent[k]==dst.extent(k));
+  }
+  detail::strided_copy(seq,dst.data()+dst.base_offset(),src.data()+src.base_offset(),std::move(extent),std::move(dst_strides),std::move(src_strides));
+}
+
+
+} // std_e
@@ -0,0 +1,387 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "std_e/base/macros.hpp"
+#include "std_e/base/msg_exception.hpp"
+#include "std_e/operation/operation_functor.hpp"
+#include "std_e/multi_array/multi_array/multi_array.hpp"
+#include "std_e/multi_array/multi_array/multi_array_types.hpp"
+#include "std_e/multi_array/multi_array/block_view.hpp"
+#include "std_e/multi_array/multi_array/strided_array.hpp"
+#include "std_e/multi_array/multi_array/contiguous_runs.hpp"
+#include "std_e/multi_array/shape/layout.hpp"
+#include "std_e/multi_index/for_each_multi_index.hpp"
+#include "std_e/utils/array.hpp"
+
+
+namespace std_e {
+
+
+/**
+  Lazy element-wise expressions over multi_arrays, block_views and strided_arrays
+    - `b*c + d` does not compute anything: it builds a tree of `multi_array_expression` nodes
+      that reference their operands (scalars are copied). The operation of each node is an `operation_kind`,
+      applied with `operation_functor`, so an element type works if it supports the operation
+    - the computation is done on assignment (`a = b*c + d`, `assign(a,b*c + d)` or `evaluate(b*c + d)`), in one loop:
+      - if `a` and all the multi_array operands are contiguous (or padded) with the same strides,
+        the loop is over the linear index (by column if padded: the padding is not touched), and is vectorized by the compiler
+      - otherwise (block_view, strided_array, different layouts...), the loop is over the multi-indices
+    - the extents of the operands are checked when the expression is built, and on assignment:
+      a mismatch throws a `msg_exception`
+  Warning: as with any expression template, the expression references its operands, so it must not outlive them,
+           and the destination of an assignment may be an operand only if it is accessed at the same index
+           (`a = a*b` is fine, `a = a + transposed(a)` is not)
+*/
+
+
+// operands {
+template<class T> constexpr bool is_expression_operand = is_multi_array_like<T> || is_multi_array_expression<T>;
+
+template<class... Ts> constexpr bool are_expression_args =
+     (is_expression_operand<Ts> || ...)
+  && ((is_expression_operand<Ts> || std::is_arithmetic_v<std::decay_t<Ts>>) && ...);
+// operands }
+
+
+// extent checking {
+template<class Multi_index_0, class Multi_index_1> auto
+same_extent(const Multi_index_0& x, const Multi_index_1& y) -> bool {
+  if (x.size()!=y.size()) return false;
+  for (size_t i=0; i<size_t(x.size()); ++i) {
+    if (x[i]!=y[i]) return false;
+  }
+  return true;
+}
+
+template<class Multi_index_0, class Multi_index_1> auto
+check_same_extent(const Multi_index_0& x, const Multi_index_1& y, const char* context) -> void {
+  if (!same_extent(x,y)) {
+    throw msg_exception(std::string(context)+": extent mismatch: "+to_string(x)+" and "+to_string(y));
+  }
+}
+// extent checking }
+
+
+// expression leaves {
+namespace detail {
+  template<class Multi_array> constexpr bool has_linear_access = false;
+  template<class R, class S> constexpr bool has_linear_access<multi_array<R,S>> = true;
+
+  template<class Layout> constexpr bool is_padded_layout = false;
+  template<int W> constexpr bool is_padded_layout<padded_layout<W>> = true;
+
+  /// The elements of `x` are the `n_run` runs of `run_size` elements starting at data()+base_offset()+r*run_stride
+  /// n_run==-1 if the elements can't be accessed by a linear index
+  struct linear_runs {
+    std::ptrdiff_t n_run;
+    std::ptrdiff_t run_size;
+    std::ptrdiff_t run_stride;
+  };
+  template<class R, class S> auto
+  linear_memory_runs(const multi_array<R,S>& x) -> linear_runs {
+    using layout_type = typename S::layout_type;
+    std::ptrdiff_t n = x.size();
+    if constexpr (std::is_same_v<layout_type,strided_layout>) {
+      bool is_dense = same_extent(x.strides(),fortran_strides(x.extent())) || same_extent(x.strides(),c_strides(x.extent()));
+      return is_dense ? linear_runs{1,n,n} : linear_runs{-1,0,0};
+    } else if constexpr (is_padded_layout<layout_type>) {
+      // one run by column: the padding is neither read nor written
+      if (x.rank()<=1 || n==0) return {1,n,n};
+      std::ptrdiff_t n0 = x.extent(0);
+      return {n/n0,n0,x.strides(1)};
+    } else {
+      return {1,n,n};
+    }
+  }
+
+  template<class T>
+  struct linear_pointer_access {
+    const T* ptr;
+    FORCE_INLINE auto operator[](std::ptrdiff_t i) const -> const T& { return ptr[i]; }
+  };
+  template<class T>
+  struct linear_scalar_access {
+    T x;
+    FORCE_INLINE auto operator[](std::ptrdiff_t) const -> const T& { return x; }
+  };
+
+  template<class Multi_array>
+  class expression_leaf {
+    public:
+      using value_type = std::remove_const_t<typename Multi_array::value_type>;
+      static constexpr int ct_rank = Multi_array::ct_rank;
+
+      explicit
+      expression_leaf(const Multi_array& x)
+        : x(&x)
+      {}
+
+      auto is_scalar() const -> bool { return false; }
+      auto extent() const -> decltype(auto) { return x->extent(); }
+
+      template<class MI> FORCE_INLINE auto
+      operator()(const MI& is) const -> value_type {
+        return (*x)(is);
+      }
+
+      template<class Strides> auto
+      has_linear_access_with(const Strides& strides) const -> bool {
+        if constexpr (has_linear_access<Multi_array>) {
+          return same_extent(x->strides(),strides);
+        } else {
+          return false;
+        }
+      }
+      auto
+      linear_access() const {
+        if constexpr (has_linear_access<Multi_array>) {
+          return linear_pointer_access<value_type>{x->data()+x->base_offset()};
+        } else {
+          return linear_scalar_access<value_type>{}; // never used, see has_linear_access_with
+        }
+      }
+    private:
+      const Multi_array* x;
+  };
+
+  template<class T>
+  class expression_scalar {
+    public:
+      using value_type = T;
+      static constexpr int ct_rank = dynamic_size;
+
+      explicit
+      expression_scalar(T x)
+        : x(x)
+      {}
+
+      auto is_scalar() const -> bool { return true; }
+      auto extent() const -> multi_index<int> { return {}; }
+
+      template<class MI> FORCE_INLINE auto
+      operator()(const MI&) const -> const T& {
+        return x;
+      }
+
+      template<class Strides> auto
+      has_linear_access_with(const Strides&) const -> bool {
+        return true;
+      }
+      auto
+      linear_access() const {
+        return linear_scalar_access<T>{x};
+      }
+    private:
+      T x;
+  };
+
+  template<class T> auto
+  make_expression_node(const T& x) {
+    if constexpr (is_multi_array_expression<T>) {
+      return x;
+    } else if constexpr (is_multi_array_like<T>) {
+      return expression_leaf<T>(x);
+    } else {
+      return expression_scalar<T>(x);
+    }
+  }
+  template<class T> using expression_node_type = decltype(make_expression_node(std::declval<const T&>()));
+}
+// expression leaves }
+
+
+// multi_array_expression {
+namespace detail {
+  template<operation_kind op_k, class... Accesses>
+  struct linear_expression_access {
+    std::tuple<Accesses...> accesses;
+
+    FORCE_INLINE auto
+    operator[](std::ptrdiff_t i) const {
+      return std::apply([i](const auto&... acc){ return operation_functor<op_k>(acc[i]...); },accesses);
+    }
+  };
+}
+
+template<operation_kind op_k, class... Nodes>
+class multi_array_expression : public multi_array_expression_base {
+  public:
+  // type traits
+    using value_type = std::decay_t<decltype(operation_functor<op_k>(std::declval<const typename Nodes::value_type&>()...))>;
+    static constexpr int ct_rank = std::max({Nodes::ct_rank...}); // dynamic_size is negative
+
+  // ctor
+    explicit
+    multi_array_expression(Nodes... nodes)
+      : nodes(std::move(nodes)...)
+    {
+      auto ext = extent();
+      std::apply([&ext](const auto&... ns){
+        ( check_node_extent(ext,ns) , ... );
+      },this->nodes);
+    }
+
+  // dimensions
+    auto
+    is_scalar() const -> bool {
+      return false;
+    }
+    auto
+    extent() const {
+      return std::apply([](const auto&... ns){ return first_non_scalar_extent(ns...); },nodes);
+    }
+    auto
+    rank() const -> int {
+      return extent().size();
+    }
+
+  // element access
+    template<class MI> FORCE_INLINE auto
+    operator()(const MI& is) const -> value_type {
+      return std::apply([&is](const auto&... ns){ return operation_functor<op_k>(ns(is)...); },nodes);
+    }
+
+  // linear access (see `assign`)
+    template<class Strides> auto
+    has_linear_access_with(const Strides& strides) const -> bool {
+      return std::apply([&strides](const auto&... ns){ return (ns.has_linear_access_with(strides) && ...); },nodes);
+    }
+    auto
+    linear_access() const {
+      return std::apply([](const auto&... ns){
+        return detail::linear_expression_access<op_k,decltype(ns.linear_access())...>{{ns.linear_access()...}};
+      },nodes);
+    }
+  private:
+    template<class Multi_index, class Node> static auto
+    check_node_extent(const Multi_index& ext, const Node& n) -> void {
+      if (!n.is_scalar()) {
+        check_same_extent(ext,n.extent(),"multi_array_expression");
+      }
+    }
+    template<class N0, class... Ns> static auto
+    first_non_scalar_extent(const N0& n0, const Ns&... ns) {
+      if constexpr (std::is_same_v<N0,detail::expression_scalar<typename N0::value_type>>) {
+        return first_non_scalar_extent(ns...);
+      } else {
+        return n0.extent();
+      }
+    }
+
+    std::tuple<Nodes...> nodes;
+};
+
+template<operation_kind op_k, class... Ts> auto
+make_multi_array_expression(const Ts&... xs) {
+  static_assert(are_expression_args<Ts...>);
+  return multi_array_expression<op_k,detail::expression_node_type<Ts>...>(detail::make_expression_node(xs)...);
+}
+// multi_array_expression }
+
+
+// operators and functions {
+#define STD_E_GENERATE_ELEMENTWISE_BINARY_OPERATOR(op_name,symbol) \
+  template<class T0, class T1, std::enable_if_t< are_expression_args<T0,T1> , int > =0> auto \
+  operator symbol(const T0& x, const T1& y) { \
+    return make_multi_array_expression<operation_kind::op_name>(x,y); \
+  }
+
+#define STD_E_GENERATE_ELEMENTWISE_FUNCTION(op_name) \
+  template<class... Ts, std::enable_if_t< are_expression_args<Ts...> , int > =0> auto \
+  op_name(const Ts&... xs) { \
+    return make_multi_array_expression<operation_kind::op_name>(xs...); \
+  }
+
+STD_E_GENERATE_ELEMENTWISE_BINARY_OPERATOR( plus       , + );
+STD_E_GENERATE_ELEMENTWISE_BINARY_OPERATOR( minus      , - );
+STD_E_GENERATE_ELEMENTWISE_BINARY_OPERATOR( multiplies , * );
+STD_E_GENERATE_ELEMENTWISE_BINARY_OPERATOR( divides    , / );
+
+template<class T, std::enable_if_t< are_expression_args<T> , int > =0> auto
+operator-(const T& x) {
+  return make_multi_array_expression<operation_kind::negates>(x);
+}
+
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( abs   );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( min   );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( max   );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( exp   );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( log   );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( pow   );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( sqrt  );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( sin   );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( cos   );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( tan   );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( atan2 );
+STD_E_GENERATE_ELEMENTWISE_FUNCTION( hypot );
+
+#undef STD_E_GENERATE_ELEMENTWISE_BINARY_OPERATOR
+#undef STD_E_GENERATE_ELEMENTWISE_FUNCTION
+// operators and functions }
+
+
+// evaluation {
+template<class Multi_array, class Expr, std::enable_if_t< is_multi_array_expression<Expr> , int > =0> auto
+assign(Multi_array&& dst, const Expr& e) -> void {
+  check_same_extent(dst.extent(),e.extent(),"assign");
+
+  if constexpr (detail::has_linear_access<std::decay_t<Multi_array>>) {
+    auto runs = detail::linear_memory_runs(dst);
+    if (runs.n_run>=0 && e.has_linear_access_with(dst.strides())) {
+      auto* d = dst.data()+dst.base_offset();
+      auto src = e.linear_access();
+      for (std::ptrdiff_t r=0; r<runs.n_run; ++r) {
+        std::ptrdiff_t start = r*runs.run_stride;
+        std::ptrdiff_t finish = start+runs.run_size;
+        for (std::ptrdiff_t i=start; i<finish; ++i) {
+          d[i] = src[i];
+        }
+      }
+      return;
+    }
+  }
+
+  for_each_multi_index(dst.extent(),[&dst,&e](const auto& is){ dst(is) = e(is); });
+}
+
+/// Copy between multi_arrays and views, by contiguous runs (see contiguous_runs.hpp)
+template<class Multi_array_0, class Multi_array_1, std::enable_if_t< is_multi_array_like<Multi_array_1> , int > =0> auto
+assign(Multi_array_0&& dst, const Multi_array_1& src) -> void {
+  check_same_extent(dst.extent(),src.extent(),"assign");
+  copy(src,dst);
+}
+
+/// Evaluates the expression into a new multi_array
+template<class Expr, std::enable_if_t< is_multi_array_expression<Expr> , int > =0> auto
+evaluate(const Expr& e) {
+  using T = typename Expr::value_type;
+  auto ext = e.extent();
+  auto dims = make_array_of_size<multi_index<int,Expr::ct_rank>>(ext.size());
+  std::copy(begin(ext),end(ext),begin(dims));
+  dyn_multi_array<T,Expr::ct_rank> res(dims);
+  assign(res,e);
+  return res;
+}
+
+#define STD_E_GENERATE_ELEMENTWISE_COMPOUND_ASSIGNMENT(op_name,symbol) \
+  template<class R, class S, class T, std::enable_if_t< are_expression_args<T> || std::is_arithmetic_v<T> , int > =0> auto \
+  operator symbol##=(multi_array<R,S>& x, const T& y) -> multi_array<R,S>& { \
+    assign(x,make_multi_array_expression<operation_kind::op_name>(x,y)); \
+    return x; \
+  }
+
+STD_E_GENERATE_ELEMENTWISE_COMPOUND_ASSIGNMENT( plus       , + );
+STD_E_GENERATE_ELEMENTWISE_COMPOUND_ASSIGNMENT( minus      , - );
+STD_E_GENERATE_ELEMENTWISE_COMPOUND_ASSIGNMENT( multiplies , * );
+STD_E_GENERATE_ELEMENTWISE_COMPOUND_ASSIGNMENT( divides    , / );
+
+#undef STD_E_GENERATE_ELEMENTWISE_COMPOUND_ASSIGNMENT
+// evaluation }
+
+
+} // std_e
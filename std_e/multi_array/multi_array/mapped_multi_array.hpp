@@ -0,0 +1,64 @@
+#pragma once
+
+
+#include <string>
+#include <type_traits>
+#include "std_e/multi_array/multi_array/multi_array.hpp"
+#include "std_e/multi_array/multi_array/multi_array_types.hpp"
+#include "std_e/memory_ressource/mapped_file.hpp"
+
+
+namespace std_e {
+
+
+/**
+  multi_array whose elements are stored in a file mapped in memory (see mapped_file.hpp)
+    - no copy: the pages of the file are loaded when accessed
+    - the element `is` is at byte `offset + linear_index(is)*sizeof(T)` of the file (Fortran order)
+    - for a file mapped read-only, use a const element type (e.g. mapped_multi_array<const double,3>)
+  Copies are shallow (as for a multi_array view)
+*/
+template<class T, int rank, class Integer = default_index_type>
+using mapped_multi_array = multi_array< mapped_range<T> , dyn_shape<Integer,rank>>;
+
+
+/// read-only for a const `T`, read-write otherwise
+template<class T> constexpr auto
+default_map_options() -> map_options {
+  map_options opts;
+  opts.mode = std::is_const_v<T> ? map_mode::read_only : map_mode::read_write;
+  return opts;
+}
+
+/// maps the multi_array of extent `dims` stored in file `file_name`, starting at byte `offset`
+/// Throws if `opts` asks for a read-only mapping of a non-const `T`
+template<class T, class Multi_index> auto
+make_mapped_multi_array(const std::string& file_name, const Multi_index& dims, map_options opts = default_map_options<T>(), std::size_t offset = 0) {
+  using I = index_type_of<Multi_index>;
+  constexpr int rank = rank_of<Multi_index>;
+  using shape_type = dyn_shape<I,rank>;
+  if (!std::is_const_v<T> && opts.mode==map_mode::read_only) {
+    throw msg_exception("make_mapped_multi_array: file \""+file_name+"\" is requested read-only, the element type should be const");
+  }
+
+  shape_type sh(dims);
+  auto f = std::make_shared<mapped_file>(file_name,opts);
+  mapped_range<T> rng(std::move(f),offset,sh.memory_size());
+  return mapped_multi_array<T,rank,I>(std::move(rng),std::move(sh));
+}
+
+/// creates file `file_name` to store a multi_array of extent `dims`, and maps it
+template<class T, class Multi_index> auto
+create_mapped_multi_array(const std::string& file_name, const Multi_index& dims, map_options opts = {}) {
+  using I = index_type_of<Multi_index>;
+  constexpr int rank = rank_of<Multi_index>;
+  using shape_type = dyn_shape<I,rank>;
+
+  shape_type sh(dims);
+  auto f = std::make_shared<mapped_file>(create_mapped_file(file_name,sh.memory_size()*sizeof(T),opts));
+  mapped_range<T> rng(std::move(f),0,sh.memory_size());
+  return mapped_multi_array<T,rank,I>(std::move(rng),std::move(sh));
+}
+
+
+} // std_e
@@ -6,6 +6,8 @@
 #include "std_e/multi_index/concept.hpp"
 #include "std_e/multi_index/multi_index.hpp"
 #include "std_e/multi_index/fortran_order.hpp"
+#include "std_e/multi_index/for_each_multi_index.hpp"
+#include "std_e/multi_array/shape/layout.hpp"
 #include "std_e/future/contract.hpp"
 #include "std_e/multi_array/multi_array/concept.hpp"
 #include "std_e/multi_index/cartesian_product_size.hpp"
@@ -13,6 +15,7 @@
 #include "std_e/memory_ressource/memory_ressource.hpp"
 #include "std_e/future/span.hpp"
 #include "std_e/meta/type_traits.hpp"
+#include <array>
 
 
 namespace std_e {
@@ -46,6 +49,13 @@ class multi_array : private Multi_array_shape {
     FORCE_INLINE constexpr multi_array& operator=(const multi_array& ) = default;
     FORCE_INLINE constexpr multi_array& operator=(      multi_array&&) = default;
 
+    /// lazy element-wise expressions are evaluated in one loop (see multi_array/expression.hpp)
+    template<class Expr, std::enable_if_t< is_multi_array_expression<Expr> , int > =0>
+    multi_array& operator=(const Expr& e) {
+      assign(*this,e);
+      return *this;
+    }
+
   /// low-level {
     FORCE_INLINE constexpr
     multi_array(underlying_range_type rng, shape_type sh)
@@ -82,7 +92,7 @@ class multi_array : private Multi_array_shape {
     >
     multi_array(Integers... dims)
       : shape_type({dims...})
-      , rng(std_e::cartesian_product_size(multi_index<int,sizeof...(Integers)>{dims...}))
+      , rng(this->memory_size())
     {
       static_assert(ct_rank==dynamic_size || sizeof...(Integers)==ct_rank);
     }
@@ -90,30 +100,43 @@ class multi_array : private Multi_array_shape {
     FORCE_INLINE constexpr
     multi_array(multi_index_type dims)
       : shape_type({std::move(dims)})
-      , rng(size())
+      , rng(this->memory_size())
     {}
     FORCE_INLINE constexpr
     multi_array(value_type* rng, multi_index_type dims)
       : shape_type({std::move(dims)})
-      , rng(make_span(rng,size()))
+      , rng(make_span(rng,this->memory_size()))
     {}
   /// ctors with dimensions }
 
   /// ctors from initializer lists {
+    /// The memory is allocated after the shape is known: it may be bigger than the number of elements (e.g. padded layout)
     //// ctor for rank==1
     multi_array(std::initializer_list<value_type> l)
-      : multi_array(l,make_array_of_size<underlying_range_type>(l.size()))
-    {}
+      : shape_type(shape_of_init_list(l))
+      , rng(make_array_of_size<underlying_range_type>(this->memory_size()))
+    {
+      assign_init_list(l);
+    }
     multi_array(std::initializer_list<value_type> l, value_type* ptr)
-      : multi_array(l,span<value_type>(ptr,l.size()))
-    {}
+      : shape_type(shape_of_init_list(l))
+      , rng(span<value_type>(ptr,this->memory_size()))
+    {
+      assign_init_list(l);
+    }
     //// ctor for rank==2
     multi_array(std::initializer_list<std::initializer_list<value_type>> ll)
-      : multi_array(ll,make_array_of_size<underlying_range_type>(ll.size() * std::begin(ll)->size()))
-    {}
+      : shape_type(shape_of_init_list(ll))
+      , rng(make_array_of_size<underlying_range_type>(this->memory_size()))
+    {
+      assign_init_list(ll);
+    }
     multi_array(std::initializer_list<std::initializer_list<value_type>> ll, value_type* ptr)
-      : multi_array(ll,span<value_type>(ptr,ll.size() * std::begin(ll)->size()))
-    {}
+      : shape_type(shape_of_init_list(ll))
+      , rng(span<value_type>(ptr,this->memory_size()))
+    {
+      assign_init_list(ll);
+    }
   /// ctors from initializer lists }
   // constructors }
 
@@ -129,7 +152,10 @@ class multi_array : private Multi_array_shape {
     using base::rank;
     using base::extent;
     using base::offset;
+    using base::strides;
+    using base::base_offset;
     using base::size;
+    using base::memory_size;
 
   // contiguous range interface
     FORCE_INLINE constexpr auto underlying_range() const -> const underlying_range_type& { return rng; }
@@ -138,10 +164,12 @@ class multi_array : private Multi_array_shape {
     FORCE_INLINE constexpr auto data() const  -> const_pointer { return rng.data(); }
     FORCE_INLINE constexpr auto data()        ->       pointer { return rng.data(); }
 
-    FORCE_INLINE constexpr auto begin() const -> const_pointer { return data();        }
-    FORCE_INLINE constexpr auto begin()       ->       pointer { return data();        }
-    FORCE_INLINE constexpr auto end()   const -> const_pointer { return data()+size(); }
-    FORCE_INLINE constexpr auto end()         ->       pointer { return data()+size(); }
+    /// [begin(),end()) are the first `size()` elements of the memory:
+    /// they are the elements of the array only if they are dense, in Fortran order
+    FORCE_INLINE constexpr auto begin() const -> const_pointer { check_dense_fortran_order(); return data();        }
+    FORCE_INLINE constexpr auto begin()       ->       pointer { check_dense_fortran_order(); return data();        }
+    FORCE_INLINE constexpr auto end()   const -> const_pointer { check_dense_fortran_order(); return data()+size(); }
+    FORCE_INLINE constexpr auto end()         ->       pointer { check_dense_fortran_order(); return data()+size(); }
 
     FORCE_INLINE constexpr auto operator[](index_type i) const -> const_reference { return rng[i]; }
     FORCE_INLINE constexpr auto operator[](index_type i)       ->       reference { return rng[i]; }
@@ -158,6 +186,14 @@ class multi_array : private Multi_array_shape {
 
   private:
   // member functions
+    FORCE_INLINE constexpr auto
+    check_dense_fortran_order() const -> void {
+      using layout_type = typename shape_type::layout_type;
+      static_assert(std::is_same_v<layout_type,fortran_layout>, // not c, strided or padded
+                    "multi_array::begin/end: the elements are not [data(),data()+size()), iterate by multi-index instead");
+      STD_E_ASSERT(base_offset()==0);
+    }
+
     // linear_index {
     /// from Multi_index
     template<
@@ -172,7 +208,7 @@ class multi_array : private Multi_array_shape {
     FORCE_INLINE constexpr auto
     linear_index(const MI& indices) const -> index_type {
       STD_E_ASSERT((int)indices.size()==rank());
-      return fortran_order_from_dimensions(extent(),offset(),indices);
+      return base::linear_index(indices);
     }
     /// from indices
     template<
@@ -187,7 +223,8 @@ class multi_array : private Multi_array_shape {
     FORCE_INLINE constexpr auto
     linear_index(Integers... is) const -> index_type {
       STD_E_ASSERT(sizeof...(Integers)==rank());
-      return linear_index(multi_index_type{is...});
+      // Note: not multi_index_type, that would allocate if the rank is dynamic
+      return base::linear_index(std::array<index_type,sizeof...(Integers)>{index_type(is)...});
     }
     FORCE_INLINE constexpr auto
     linear_index() const -> index_type { // Note: rank 0 case // TODO why fortran_order_from_dimensions does not return 0?
@@ -196,10 +233,16 @@ class multi_array : private Multi_array_shape {
     // linear_index }
 
     // initialization list ctors {
-    multi_array(std::initializer_list<value_type> l, underlying_range_type rng)
-      : shape_type(make_shape<shape_type>({index_type(l.size())},{0}))
-      , rng(std::move(rng))
-    {
+    static auto
+    shape_of_init_list(std::initializer_list<value_type> l) -> shape_type {
+      return make_shape<shape_type>({index_type(l.size())},{0});
+    }
+    static auto
+    shape_of_init_list(std::initializer_list<std::initializer_list<value_type>> ll) -> shape_type {
+      return make_shape<shape_type>({index_type(ll.size()),index_type(std::begin(ll)->size())},{0,0});
+    }
+    auto
+    assign_init_list(std::initializer_list<value_type> l) -> void {
       STD_E_ASSERT(this->rank()==1);
       index_type i=0;
       for (const value_type& x : l) {
@@ -207,10 +250,8 @@ class multi_array : private Multi_array_shape {
         ++i;
       }
     }
-    multi_array(std::initializer_list<std::initializer_list<value_type>> ll, underlying_range_type rng)
-      : shape_type(make_shape<shape_type>({index_type(ll.size()),index_type(std::begin(ll)->size())},{0,0}))
-      , rng(std::move(rng))
-    {
+    auto
+    assign_init_list(std::initializer_list<std::initializer_list<value_type>> ll) -> void {
       STD_E_ASSERT(this->rank()==2);
       index_type i=0;
       for (const auto& l : ll) {
@@ -228,12 +269,26 @@ class multi_array : private Multi_array_shape {
     underlying_range_type rng;
 };
 
+/// same extent and same elements (whatever the memory layouts)
 template<class M00, class M01, class M10, class M11> constexpr auto
 operator==(const multi_array<M00,M01>& x, const multi_array<M10,M11>& y) -> bool {
-  if (x.size()!=y.size()) return false;
+  if (x.rank()!=y.rank()) return false;
+  for (int k=0; k<x.rank(); ++k) {
+    if (x.extent(k)!=y.extent(k)) return false;
+  }
   if (x.size()==0) return true;
-  auto mismatch_its = std::mismatch(x.begin(),x.end(),y.begin());
-  return mismatch_its.first==x.end();
+
+  using layout_0 = typename M01::layout_type;
+  using layout_1 = typename M11::layout_type;
+  if constexpr (std::is_same_v<layout_0,fortran_layout> && std::is_same_v<layout_1,fortran_layout>) {
+    // same dense memory order: compare the memory
+    const auto* first = x.data()+x.base_offset();
+    return std::equal(first,first+x.size(),y.data()+y.base_offset());
+  } else {
+    bool eq = true;
+    for_each_multi_index(x.extent(),[&x,&y,&eq](const auto& is){ eq = eq && x(is)==y(is); });
+    return eq;
+  }
 }
 template<class M00, class M01, class M10, class M11> constexpr auto
 operator!=(const multi_array<M00,M01>& x, const multi_array<M10,M11>& y) -> bool {
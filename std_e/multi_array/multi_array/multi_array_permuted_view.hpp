@@ -5,6 +5,10 @@
 #include "std_e/memory_ressource/concept.hpp"
 #include "std_e/multi_array/multi_array/concept.hpp"
 #include "std_e/multi_index/multi_index.hpp"
+#include "std_e/meta/type_traits.hpp"
+#include "std_e/utils/array.hpp"
+#include <algorithm>
+#include <array>
 
 
 namespace std_e {
@@ -17,7 +21,7 @@ namespace std_e {
 struct reversing_permutation {
   template<class Multi_index> constexpr auto
   permute(const Multi_index& is) const -> Multi_index {
-    Multi_index inv_is(is.size());
+    auto inv_is = make_array_of_size<Multi_index>(is.size());
     std::reverse_copy(begin(is),end(is),begin(inv_is));
     return inv_is;
   }
@@ -50,7 +54,7 @@ class multi_array_permuted_view : private Multi_array_shape, private Permutation
     using reference = value_type&;
     using const_reference = const value_type&;
 
-    static constexpr size_t fixed_rank = shape_type::fixed_rank;
+    static constexpr int ct_rank = shape_type::ct_rank;
 
   // constructors
     FORCE_INLINE constexpr multi_array_permuted_view() = default;
@@ -99,25 +103,22 @@ class multi_array_permuted_view : private Multi_array_shape, private Permutation
 
   /// fortran_linear_index { // TODO factorize with multi_array
   // from Multi_index
-    template<class Multi_index> FORCE_INLINE constexpr auto
+    template<class Multi_index, std::enable_if_t< !std::is_integral_v<Multi_index> , int > =0> FORCE_INLINE constexpr auto
     // requires Multi_index is an array && Multi_index::size()==rank()
     fortran_linear_index(const Multi_index& indices) const -> index_type {
       auto source_indices = permute(indices);
-      return fortran_order_from_dimensions(source_shape->extent(),source_shape->offset(),source_indices);
+      return source_shape->linear_index(source_indices);
     }
   // from indices
-    template<class... ints> FORCE_INLINE constexpr auto
-    // requires ints are integers && sizeof...(ints)==rank()
-    fortran_linear_index(index_type i, ints... is) const -> index_type {
-      STD_E_ASSERT(1+sizeof...(ints)==rank()); // the number of indices must be the array rank
-      return fortran_linear_index(multi_index_type{i,is...});
-    }
-    template<class... ints> FORCE_INLINE constexpr auto
-    // requires ints are integers && sizeof...(ints)==rank()
-    fortran_linear_index(int i, ints... is) const -> index_type { // Note: same as above, but forcing first arg
-                                                                  // to be an integer for unsurprising overload resolution
-      STD_E_ASSERT(1+sizeof...(ints)==rank()); // the number of indices must be the array rank
-      return fortran_linear_index(multi_index_type{i,is...});
+    template<
+      class... Integers,
+      std::enable_if_t< are_integral<Integers...> , int > =0
+    >
+    FORCE_INLINE constexpr auto
+    fortran_linear_index(Integers... is) const -> index_type {
+      STD_E_ASSERT(sizeof...(Integers)==rank()); // the number of indices must be the array rank
+      // Note: not multi_index_type, that would allocate if the rank is dynamic
+      return fortran_linear_index(std::array<index_type,sizeof...(Integers)>{index_type(is)...});
     }
   /// fortran_linear_index }
   // data member
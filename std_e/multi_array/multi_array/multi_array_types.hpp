@@ -4,6 +4,8 @@
 #include <array>
 #include <vector>
 #include "std_e/future/span.hpp"
+#include "std_e/memory_ressource/aligned_allocator.hpp"
+#include "std_e/memory_ressource/default_init_allocator.hpp"
 #include "std_e/multi_array/shape/fixed_shape.hpp"
 #include "std_e/multi_array/shape/dyn_shape.hpp"
 #include "std_e/base/dynamic_size.hpp"
@@ -34,4 +36,38 @@ using dyn_multi_array_view = multi_array< std_e::span<T,dynamic_size> , dyn_shap
 // dyn_multi_array }
 
 
+// other layouts {
+/// View of row-major memory (e.g. numpy or HDF5 buffers), without copy
+template<class T, int rank, class Integer = default_index_type>
+using c_multi_array_view = multi_array< std_e::span<T,dynamic_size> , dyn_shape<Integer,rank,c_layout>>;
+
+/// View of memory with arbitrary strides (given by the shape)
+template<class T, int rank, class Integer = default_index_type>
+using strided_multi_array_view = multi_array< std_e::span<T,dynamic_size> , dyn_shape<Integer,rank,strided_layout>>;
+// other layouts }
+
+
+// aligned storage {
+/// Elements of size `sizeof(T)` by SIMD vector of `simd_bytes` bytes
+template<class T, int simd_bytes = 64> constexpr int simd_width = simd_bytes/sizeof(T) > 0 ? simd_bytes/sizeof(T) : 1;
+
+/// Memory aligned on 64 bytes (a cache line, an AVX-512 vector)
+template<class T, int rank, class Integer = default_index_type>
+using aligned_multi_array = multi_array< aligned_vector<T,64> , dyn_shape<Integer,rank>>;
+
+/// Memory aligned on 64 bytes, and first dimension padded to a multiple of 64 bytes:
+/// each column x(0,j,k...) is aligned, so that loops over the first index can use aligned SIMD loads
+template<class T, int rank, class Integer = default_index_type>
+using padded_multi_array = multi_array< aligned_vector<T,64> , dyn_shape<Integer,rank,padded_layout<simd_width<T>>>>;
+// aligned storage }
+
+
+// uninitialized storage {
+/// Same as aligned_multi_array, but the elements are not initialized by the constructor:
+/// the memory pages are touched first by the code that writes the elements (e.g. `fill(par,x,value)`, see parallel_fill_copy.hpp)
+template<class T, int rank, class Integer = default_index_type>
+using uninitialized_multi_array = multi_array< default_init_vector<T,aligned_allocator<T,64>> , dyn_shape<Integer,rank>>;
+// uninitialized storage }
+
+
 } // std_e
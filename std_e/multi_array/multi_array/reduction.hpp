@@ -0,0 +1,387 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "std_e/base/macros.hpp"
+#include "std_e/future/contract.hpp"
+#include "std_e/execution/execution.hpp"
+#include "std_e/operation/operation_functor.hpp"
+#include "std_e/multi_array/multi_array/contiguous_runs.hpp"
+#include "std_e/multi_array/multi_array/multi_array_types.hpp"
+#include "std_e/multi_index/for_each_multi_index.hpp"
+
+
+namespace std_e {
+
+
+/**
+  Reductions of multi_arrays and of their views (block_view, strided_array)
+    - full reductions: reduce(x,init,op), sum, prod, min_value, max_value, argmin, argmax
+    - reductions along one axis: reduce_axis(x,axis,init,op), sum_axis, prod_axis, min_axis, max_axis
+      the result is a dyn_multi_array of rank x.rank()-1
+  `op` must be associative and commutative (e.g. operation_functor<operation_kind::plus>, std::plus<>, a lambda...)
+  The type of `init` is the type of the accumulators and of the result (e.g. a double `init` sums a float array in double)
+
+  Full reductions loop over the contiguous runs of `x` (see contiguous_runs.hpp)
+  and each run is reduced with `n_reduction_lanes` independent accumulators, so that the compiler can use SIMD registers
+  Reductions along an axis are done row by row of the result, so that the inner loop is contiguous in memory (if the reduced axis is not the contiguous one)
+
+  With a parallel_policy, the array is split along its outermost dimension and each part is reduced by one thread
+  For full reductions, the order in which the elements are combined depends on the number of threads,
+  and so does the result for floating point sums
+  If `reduction_order::deterministic` is given, the array is split into blocks of about `grain_size` elements
+  that only depend on the extent, and the blocks are combined in order: the result does not depend on the number of threads
+  Reductions along an axis are always deterministic (each element of the result is reduced by only one thread)
+*/
+enum class reduction_order { unspecified, deterministic };
+
+
+namespace detail {
+  constexpr int n_reduction_lanes = 8;
+
+  /// op(init,p[0],...,p[n-1]), with independent accumulators
+  /// The element type `V` may differ from the accumulator type `T` (e.g. floats summed in double)
+  template<class V, class T, class Op> FORCE_INLINE auto
+  reduce_run(const V* p, std::ptrdiff_t n, T init, Op& op) -> T {
+    constexpr int W = n_reduction_lanes;
+    if (n<W) {
+      for (std::ptrdiff_t i=0; i<n; ++i) {
+        init = op(init,p[i]);
+      }
+      return init;
+    }
+
+    T acc[W];
+    for (int j=0; j<W; ++j) {
+      acc[j] = T(p[j]);
+    }
+    std::ptrdiff_t i = W;
+    for (; i+W<=n; i+=W) {
+      for (int j=0; j<W; ++j) {
+        acc[j] = op(acc[j],p[i+j]);
+      }
+    }
+    for (int j=0; j<W; ++j) {
+      init = op(init,acc[j]);
+    }
+    for (; i<n; ++i) {
+      init = op(init,p[i]);
+    }
+    return init;
+  }
+
+  /// reduction of the elements at `first + sum_k is[k]*strides[k]`, starting with `T(*first)` (no initial value)
+  /// Precondition: `extent` and `strides` are given by `merge_contiguous_dims`
+  template<class T, class V, class Op> auto
+  reduce_strided(const V* first, const std::vector<std::ptrdiff_t>& extent, const std::vector<std::ptrdiff_t>& strides, Op& op) -> T {
+    T res = T(*first);
+    bool is_first_run = true;
+    for_each_run(first,extent,strides,[&](const V* p, std::ptrdiff_t n){
+      if (is_first_run) {
+        res = reduce_run(p+1,n-1,res,op);
+        is_first_run = false;
+      } else {
+        res = reduce_run(p,n,res,op);
+      }
+    });
+    return res;
+  }
+
+  template<class V, class T, class Op> auto
+  reduce_strided(sequential_policy, const V* first, const std::vector<std::ptrdiff_t>& extent, const std::vector<std::ptrdiff_t>& strides, T init, Op& op, reduction_order) -> T {
+    return op(init,reduce_strided<T>(first,extent,strides,op));
+  }
+  template<class V, class T, class Op> auto
+  reduce_strided(const parallel_policy& pol, const V* first, const std::vector<std::ptrdiff_t>& extent, const std::vector<std::ptrdiff_t>& strides, T init, Op& op, reduction_order order) -> T {
+    using I = std::ptrdiff_t;
+    int rank = extent.size();
+    I n = 1;
+    for (I e : extent) n *= e;
+
+    int n_chk = n_chunk(pol,n);
+    I n_block = n_chk;
+    if (order==reduction_order::deterministic) {
+      n_block = std::max(I(1),n/std::max(pol.grain_size,I(1)));
+    }
+    if (rank>0) n_block = std::min(n_block,extent[rank-1]);
+    if (rank==0 || n_block==1) {
+      return reduce_strided(seq,first,extent,strides,init,op,order);
+    }
+
+    // the dimensions are sorted by stride: split the last one in blocks
+    int outer_dim = rank-1;
+    std::vector<I> block_bounds(n_block+1);
+    uniform_distribution(begin(block_bounds),end(block_bounds),extent[outer_dim]);
+    std::vector<T> block_results(n_block,init);
+    for_each_chunk(std::min(I(n_chk),n_block),n_block,[&](int, I start, I finish){
+      for (I b=start; b<finish; ++b) {
+        std::vector<I> block_extent = extent;
+        block_extent[outer_dim] = block_bounds[b+1]-block_bounds[b];
+        block_results[b] = reduce_strided<T>(first+block_bounds[b]*strides[outer_dim],block_extent,strides,op);
+      }
+    });
+    for (const T& block_res : block_results) {
+      init = op(init,block_res);
+    }
+    return init;
+  }
+
+  /// Calls `f(offset_0,offset_1)` for each row start `is`, (i.e. is[0]==0), with offset_i = sum_k is[k]*strides_i[k]
+  template<class F> auto
+  for_each_row_offsets(const std::vector<std::ptrdiff_t>& extent, const std::vector<std::ptrdiff_t>& strides_0, const std::vector<std::ptrdiff_t>& strides_1, F&& f) -> void {
+    using I = std::ptrdiff_t;
+    int rank = extent.size();
+    for (int k=0; k<rank; ++k) {
+      if (extent[k]==0) return;
+    }
+    I off_0 = 0;
+    I off_1 = 0;
+    std::vector<I> is(rank,0);
+    while (true) {
+      f(off_0,off_1);
+      int k = 1;
+      for (; k<rank; ++k) {
+        ++is[k];
+        off_0 += strides_0[k];
+        off_1 += strides_1[k];
+        if (is[k]<extent[k]) break;
+        off_0 -= extent[k]*strides_0[k];
+        off_1 -= extent[k]*strides_1[k];
+        is[k] = 0;
+      }
+      if (k>=rank) return;
+    }
+  }
+
+  /// res[is] = op(res[is],src[is + i*axis_stride]) for i in [0,axis_extent)
+  /// Precondition: `res` is contiguous in dimension 0 (res_strides[0]==1)
+  template<class T, class V, class Op> auto
+  reduce_axis_strided(
+    T* res, const V* src,
+    const std::vector<std::ptrdiff_t>& extent, const std::vector<std::ptrdiff_t>& res_strides, const std::vector<std::ptrdiff_t>& src_strides,
+    std::ptrdiff_t axis_extent, std::ptrdiff_t axis_stride, Op& op
+  ) -> void
+  {
+    using I = std::ptrdiff_t;
+    I n_0 = extent[0];
+    I src_stride_0 = src_strides[0];
+    if (axis_stride==1) {
+      // the reduced axis is contiguous: one run by element of the result
+      for_each_row_offsets(extent,res_strides,src_strides,[&](I off_res, I off_src){
+        T* r = res+off_res;
+        const V* s = src+off_src;
+        for (I j=0; j<n_0; ++j) {
+          r[j] = reduce_run(s+j*src_stride_0,axis_extent,r[j],op);
+        }
+      });
+    } else {
+      // the row of the result stays in cache while looping over the reduced axis
+      for_each_row_offsets(extent,res_strides,src_strides,[&](I off_res, I off_src){
+        T* RESTRICT r = res+off_res;
+        for (I i=0; i<axis_extent; ++i) {
+          const V* s = src+off_src+i*axis_stride;
+          if (src_stride_0==1) {
+            for (I j=0; j<n_0; ++j) {
+              r[j] = op(r[j],s[j]);
+            }
+          } else {
+            for (I j=0; j<n_0; ++j) {
+              r[j] = op(r[j],s[j*src_stride_0]);
+            }
+          }
+        }
+      });
+    }
+  }
+
+  template<class T, class V, class Op> auto
+  reduce_axis_strided(sequential_policy, T* res, const V* src, const std::vector<std::ptrdiff_t>& extent, const std::vector<std::ptrdiff_t>& res_strides, const std::vector<std::ptrdiff_t>& src_strides, std::ptrdiff_t axis_extent, std::ptrdiff_t axis_stride, Op& op) -> void {
+    reduce_axis_strided(res,src,extent,res_strides,src_strides,axis_extent,axis_stride,op);
+  }
+  template<class T, class V, class Op> auto
+  reduce_axis_strided(const parallel_policy& pol, T* res, const V* src, const std::vector<std::ptrdiff_t>& extent, const std::vector<std::ptrdiff_t>& res_strides, const std::vector<std::ptrdiff_t>& src_strides, std::ptrdiff_t axis_extent, std::ptrdiff_t axis_stride, Op& op) -> void {
+    using I = std::ptrdiff_t;
+    int outer_dim = extent.size()-1;
+    I n = axis_extent;
+    for (I e : extent) n *= e;
+    I n_chk = std::min(I(n_chunk(pol,n)),extent[outer_dim]);
+    if (n_chk<=1) {
+      return reduce_axis_strided(res,src,extent,res_strides,src_strides,axis_extent,axis_stride,op);
+    }
+
+    for_each_chunk(n_chk,extent[outer_dim],[&](int, I start, I finish){
+      std::vector<I> chunk_extent = extent;
+      chunk_extent[outer_dim] = finish-start;
+      reduce_axis_strided(res+start*res_strides[outer_dim],src+start*src_strides[outer_dim],chunk_extent,res_strides,src_strides,axis_extent,axis_stride,op);
+    });
+  }
+
+  template<class Multi_array> using reduction_value_type = std::remove_cv_t<typename std::decay_t<Multi_array>::value_type>;
+
+  template<class Multi_array> constexpr int axis_reduction_rank =
+    std::decay_t<Multi_array>::ct_rank==dynamic_size ? dynamic_size : std::decay_t<Multi_array>::ct_rank-1;
+
+  template<class Multi_array, class T> using axis_reduction_type =
+    dyn_multi_array<T,axis_reduction_rank<Multi_array>,typename std::decay_t<Multi_array>::index_type>;
+}
+
+
+// full reductions {
+template<class Policy, class Multi_array, class T, class Op,
+  std::enable_if_t< is_execution_policy<Policy> && is_multi_array_like<Multi_array> , int > =0
+> auto
+reduce(const Policy& pol, const Multi_array& x, T init, Op op, reduction_order order = reduction_order::unspecified) -> T {
+  auto [extent,strides] = detail::extent_and_strides(x);
+  auto strides_copy = strides;
+  if (!detail::merge_contiguous_dims(extent,strides,strides_copy)) return init; // empty
+  return detail::reduce_strided(pol,x.data()+x.base_offset(),extent,strides,init,op,order);
+}
+template<class Multi_array, class T, class Op, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto
+reduce(const Multi_array& x, T init, Op op) -> T {
+  return reduce(seq,x,std::move(init),std::move(op));
+}
+
+template<class Policy, class Multi_array, std::enable_if_t< is_execution_policy<Policy> && is_multi_array_like<Multi_array> , int > =0> auto
+sum(const Policy& pol, const Multi_array& x, reduction_order order = reduction_order::unspecified) {
+  using T = detail::reduction_value_type<Multi_array>;
+  return reduce(pol,x,T(0),operation_functor<operation_kind::plus>,order);
+}
+template<class Policy, class Multi_array, std::enable_if_t< is_execution_policy<Policy> && is_multi_array_like<Multi_array> , int > =0> auto
+prod(const Policy& pol, const Multi_array& x, reduction_order order = reduction_order::unspecified) {
+  using T = detail::reduction_value_type<Multi_array>;
+  return reduce(pol,x,T(1),operation_functor<operation_kind::multiplies>,order);
+}
+/// Precondition: x.size()>0
+template<class Policy, class Multi_array, std::enable_if_t< is_execution_policy<Policy> && is_multi_array_like<Multi_array> , int > =0> auto
+min_value(const Policy& pol, const Multi_array& x) {
+  using T = detail::reduction_value_type<Multi_array>;
+  STD_E_ASSERT(x.size()>0);
+  return reduce(pol,x,T(x.data()[x.base_offset()]),operation_functor<operation_kind::min>);
+}
+/// Precondition: x.size()>0
+template<class Policy, class Multi_array, std::enable_if_t< is_execution_policy<Policy> && is_multi_array_like<Multi_array> , int > =0> auto
+max_value(const Policy& pol, const Multi_array& x) {
+  using T = detail::reduction_value_type<Multi_array>;
+  STD_E_ASSERT(x.size()>0);
+  return reduce(pol,x,T(x.data()[x.base_offset()]),operation_functor<operation_kind::max>);
+}
+
+template<class Multi_array, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto
+sum(const Multi_array& x) {
+  return sum(seq,x);
+}
+template<class Multi_array, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto
+prod(const Multi_array& x) {
+  return prod(seq,x);
+}
+template<class Multi_array, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto
+min_value(const Multi_array& x) {
+  return min_value(seq,x);
+}
+template<class Multi_array, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto
+max_value(const Multi_array& x) {
+  return max_value(seq,x);
+}
+
+/// multi-index of the first minimum element, in Fortran order
+/// Precondition: x.size()>0
+template<class Multi_array, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto
+argmin(const Multi_array& x) {
+  STD_E_ASSERT(x.size()>0);
+  auto res = make_zero_multi_index<typename Multi_array::multi_index_type>(x.rank());
+  auto min_val = x(res);
+  for_each_multi_index(x.extent(),[&](const auto& is){
+    if (x(is)<min_val) {
+      min_val = x(is);
+      res = is;
+    }
+  });
+  return res;
+}
+/// multi-index of the first maximum element, in Fortran order
+/// Precondition: x.size()>0
+template<class Multi_array, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto
+argmax(const Multi_array& x) {
+  STD_E_ASSERT(x.size()>0);
+  auto res = make_zero_multi_index<typename Multi_array::multi_index_type>(x.rank());
+  auto max_val = x(res);
+  for_each_multi_index(x.extent(),[&](const auto& is){
+    if (max_val<x(is)) {
+      max_val = x(is);
+      res = is;
+    }
+  });
+  return res;
+}
+// full reductions }
+
+
+// reductions along an axis {
+/// res(is_without_axis) = op(init, x(is with is[axis]=0), ..., x(is with is[axis]=x.extent(axis)-1))
+template<class Policy, class Multi_array, class T, class Op,
+  std::enable_if_t< is_execution_policy<Policy> && is_multi_array_like<Multi_array> , int > =0
+> auto
+reduce_axis(const Policy& pol, const Multi_array& x, int axis, T init, Op op) -> detail::axis_reduction_type<Multi_array,T> {
+  using I = std::ptrdiff_t;
+  using result_type = detail::axis_reduction_type<Multi_array,T>;
+  using res_multi_index_type = typename result_type::multi_index_type;
+  int rank = x.rank();
+  STD_E_ASSERT(0<=axis && axis<rank);
+
+  auto res_dims = make_array_of_size<res_multi_index_type>(rank-1);
+  std::vector<I> extent;
+  std::vector<I> src_strides;
+  for (int k=0; k<rank; ++k) {
+    if (k!=axis) {
+      res_dims[extent.size()] = x.extent(k);
+      extent.push_back(x.extent(k));
+      src_strides.push_back(x.strides(k));
+    }
+  }
+  result_type res(res_dims);
+  std::fill(res.data(),res.data()+res.size(),init);
+  if (res.size()==0 || x.extent(axis)==0) return res;
+
+  if (extent.empty()) { // the result is a scalar
+    extent = {1};
+    src_strides = {0};
+  }
+  std::vector<I> res_strides(extent.size());
+  res_strides[0] = 1;
+  for (int k=1; k<(int)extent.size(); ++k) {
+    res_strides[k] = res_strides[k-1]*extent[k-1];
+  }
+
+  detail::reduce_axis_strided(pol,res.data(),x.data()+x.base_offset(),extent,res_strides,src_strides,I(x.extent(axis)),I(x.strides(axis)),op);
+  return res;
+}
+template<class Multi_array, class T, class Op, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto
+reduce_axis(const Multi_array& x, int axis, T init, Op op) {
+  return reduce_axis(seq,x,axis,std::move(init),std::move(op));
+}
+
+#define STD_E_GENERATE_AXIS_REDUCTION(func_name, init_value, op_k) \
+  template<class Policy, class Multi_array, std::enable_if_t< is_execution_policy<Policy> && is_multi_array_like<Multi_array> , int > =0> auto \
+  func_name(const Policy& pol, const Multi_array& x, int axis) { \
+    using T = detail::reduction_value_type<Multi_array>; \
+    return reduce_axis(pol,x,axis,init_value,operation_functor<operation_kind::op_k>); \
+  } \
+  template<class Multi_array, std::enable_if_t< is_multi_array_like<Multi_array> , int > =0> auto \
+  func_name(const Multi_array& x, int axis) { \
+    return func_name(seq,x,axis); \
+  }
+
+STD_E_GENERATE_AXIS_REDUCTION( sum_axis , T(0), plus       )
+STD_E_GENERATE_AXIS_REDUCTION( prod_axis, T(1), multiplies )
+STD_E_GENERATE_AXIS_REDUCTION( min_axis , std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max(), min )
+STD_E_GENERATE_AXIS_REDUCTION( max_axis , std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest(), max )
+
+#undef STD_E_GENERATE_AXIS_REDUCTION
+// reductions along an axis }
+
+
+} // std_e
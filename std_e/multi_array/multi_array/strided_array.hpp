@@ -117,6 +117,34 @@ class strided_array : private Multi_array_shape {
       return cartesian_product_size(this->extent());
     }
 
+  // memory
+    // Same meaning as for multi_array: element `is` is at data()[base_offset() + sum_k is[k]*strides(k)]
+    auto
+    strides() const -> multi_index_type {
+      auto res = make_array_of_size<multi_index_type>(rank());
+      int n_fixed = fixed_dim_indices.size();
+      int origin_rank = n_fixed + rank();
+      int k = 0;
+      int k0 = 0;
+      for (int i=0; i<origin_rank; ++i) {
+        if (k0<n_fixed && i==fixed_dim_indices[k0]) {
+          ++k0;
+        } else {
+          res[k] = origin_ma.strides(i);
+          ++k;
+        }
+      }
+      return res;
+    }
+    auto
+    strides(int i) const -> index_type {
+      return strides()[i];
+    }
+    auto
+    base_offset() const -> index_type {
+      return linear_index(make_zero_multi_index<multi_index_type>(rank()));
+    }
+
   // element access
     template<class... Ts> FORCE_INLINE constexpr auto
     operator()(Ts&&... xs) const -> const_reference {
@@ -136,7 +164,7 @@ class strided_array : private Multi_array_shape {
     // requires Multi_index is an array && Multi_index::size()==rank()
     linear_index(const Multi_index0& indices) const -> index_type {
       auto origin_is = origin_indices(fixed_dim_indices,fixed_indices,indices);
-      return fortran_order_from_dimensions(origin_ma.extent(),origin_ma.offset(),origin_is);
+      return origin_ma.shape().linear_index(origin_is);
     }
   // from indices
     template<class Integer, class... Integers> FORCE_INLINE constexpr auto
@@ -0,0 +1,93 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/multi_array/multi_array/contiguous_runs.hpp"
+#include "std_e/multi_array/multi_array/expression.hpp"
+#include "std_e/multi_array/multi_array.hpp"
+
+using namespace std_e;
+
+
+namespace {
+
+auto
+make_iota_array(int n_i, int n_j) {
+  dyn_multi_array<int,2> x(n_i,n_j);
+  for (int j=0; j<n_j; ++j) {
+    for (int i=0; i<n_i; ++i) {
+      x(i,j) = i+10*j;
+    }
+  }
+  return x;
+}
+
+template<class Multi_array> auto
+run_sizes(Multi_array&& x) -> std::vector<int> {
+  std::vector<int> sizes;
+  for_each_contiguous_run(x,[&sizes](auto run){ sizes.push_back(run.size()); });
+  return sizes;
+}
+
+} // anonymous
+
+
+TEST_CASE("for_each_contiguous_run") {
+  auto x = make_iota_array(4,3);
+
+  SUBCASE("multi_array") {
+    CHECK( run_sizes(x) == std::vector<int>{12} );
+  }
+  SUBCASE("block_view") {
+    auto b = make_block_view(x,multi_index<int,2>{1,1},multi_index<int,2>{2,2});
+    CHECK( b.base_offset() == 1+4*1 );
+
+    std::vector<int> elts;
+    for_each_contiguous_run(b,[&elts](auto run){ elts.insert(end(elts),run.begin(),run.end()); });
+    CHECK( elts == std::vector<int>{11,12,21,22} );
+    CHECK( run_sizes(b) == std::vector<int>{2,2} );
+  }
+  SUBCASE("block_view of whole columns") {
+    auto b = make_block_view(x,multi_index<int,2>{0,1},multi_index<int,2>{4,2});
+    CHECK( run_sizes(b) == std::vector<int>{8} );
+  }
+  SUBCASE("strided_array") {
+    auto row_1 = make_strided_array(x,0,1); // fix axis 0 at index 1
+    CHECK( row_1.strides() == multi_index<int,1>{4} );
+    CHECK( row_1.base_offset() == 1 );
+    CHECK( run_sizes(row_1) == std::vector<int>{1,1,1} );
+
+    auto col_2 = make_strided_array(x,1,2); // fix axis 1 at index 2
+    CHECK( col_2.strides() == multi_index<int,1>{1} );
+    CHECK( run_sizes(col_2) == std::vector<int>{4} );
+  }
+  SUBCASE("padded multi_array") {
+    padded_multi_array<double,2> p(3,2);
+    CHECK( run_sizes(p) == std::vector<int>{3,3} );
+  }
+}
+
+TEST_CASE("fill and copy by contiguous runs") {
+  auto x = make_iota_array(4,3);
+
+  SUBCASE("fill a block") {
+    fill(make_block_view(x,multi_index<int,2>{1,1},multi_index<int,2>{2,2}),-1);
+    CHECK( x == dyn_multi_array<int,2>{{0,10,20},{1,-1,-1},{2,-1,-1},{3,13,23}} );
+  }
+  SUBCASE("copy a block to a multi_array") {
+    dyn_multi_array<int,2> y(2,2);
+    copy(make_block_view(x,multi_index<int,2>{2,0},multi_index<int,2>{2,2}),y);
+    CHECK( y == dyn_multi_array<int,2>{{2,12},{3,13}} );
+  }
+  SUBCASE("copy between blocks") {
+    auto src = make_block_view(x,multi_index<int,2>{0,0},multi_index<int,2>{2,2});
+    auto dst = make_block_view(x,multi_index<int,2>{2,1},multi_index<int,2>{2,2});
+    copy(src,dst);
+    CHECK( x == dyn_multi_array<int,2>{{0,10,20},{1,11,21},{2,0,10},{3,1,11}} );
+  }
+  SUBCASE("assign with a different contiguous dimension") {
+    dyn_multi_array<int,1> y(3);
+    assign(y,make_strided_array(x,0,3));
+    CHECK( y == dyn_multi_array<int,1>{3,13,23} );
+
+    dyn_multi_array<int,1> z(4);
+    CHECK_THROWS_AS( assign(z,make_strided_array(x,0,3)) , msg_exception );
+  }
+}
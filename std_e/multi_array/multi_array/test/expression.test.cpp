@@ -0,0 +1,126 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/multi_array/multi_array/expression.hpp"
+#include "std_e/multi_array/multi_array.hpp"
+
+using namespace std_e;
+
+
+TEST_CASE("multi_array expressions") {
+  dyn_multi_array<double,2> b = {{1.,2.,3.},{4.,5.,6.}};
+  dyn_multi_array<double,2> c = {{2.,2.,2.},{3.,3.,3.}};
+  dyn_multi_array<double,2> d = {{1.,0.,1.},{0.,1.,0.}};
+
+  SUBCASE("lazy") {
+    auto e = b*c + d;
+    CHECK( e.extent() == multi_index<int,2>{2,3} );
+    CHECK( e(multi_index<int,2>{1,2}) == 6.*3.+0. );
+
+    b(1,2) = 10.;
+    CHECK( e(multi_index<int,2>{1,2}) == 10.*3.+0. ); // not computed before access
+  }
+  SUBCASE("assignment") {
+    dyn_multi_array<double,2> a(2,3);
+    a = b*c + d;
+    CHECK( a == dyn_multi_array<double,2>{{3.,4.,7.},{12.,16.,18.}} );
+  }
+  SUBCASE("scalars and unary operations") {
+    dyn_multi_array<double,2> a(2,3);
+    a = -(2.*b - 1.)/c;
+    CHECK( a == dyn_multi_array<double,2>{{-0.5,-1.5,-2.5},{-7./3.,-3.,-11./3.}} );
+
+    a = max(b,3.5) + sqrt(c*c);
+    CHECK( a == dyn_multi_array<double,2>{{5.5,5.5,5.5},{7.,8.,9.}} );
+  }
+  SUBCASE("compound assignment") {
+    b += c;
+    CHECK( b == dyn_multi_array<double,2>{{3.,4.,5.},{7.,8.,9.}} );
+    b *= 2.;
+    CHECK( b == dyn_multi_array<double,2>{{6.,8.,10.},{14.,16.,18.}} );
+  }
+  SUBCASE("evaluate") {
+    auto a = evaluate(b - d);
+    CHECK( a == dyn_multi_array<double,2>{{0.,2.,2.},{4.,4.,6.}} );
+  }
+  SUBCASE("integer elements") {
+    dyn_multi_array<int,1> x = {1,2,3};
+    dyn_multi_array<int,1> y = {4,5,6};
+    dyn_multi_array<int,1> z(3);
+    z = x*y - x;
+    CHECK( z == dyn_multi_array<int,1>{3,8,15} );
+  }
+  SUBCASE("extent mismatch") {
+    dyn_multi_array<double,2> e(3,2);
+    CHECK_THROWS_AS( b + e , msg_exception );
+
+    dyn_multi_array<double,2> a(3,2);
+    CHECK_THROWS_AS( a = b + c , msg_exception );
+  }
+}
+
+TEST_CASE("multi_array expressions over views") {
+  dyn_multi_array<int,2> x = {
+    {1,2,3,4},
+    {5,6,7,8},
+    {9,10,11,12}
+  };
+
+  SUBCASE("block_view") {
+    auto top_left     = make_block_view(x,multi_index<int,2>{0,0},multi_index<int,2>{2,2});
+    auto bottom_right = make_block_view(x,multi_index<int,2>{1,2},multi_index<int,2>{2,2});
+    dyn_multi_array<int,2> a(2,2);
+    a = top_left + 10*bottom_right;
+    CHECK( a == dyn_multi_array<int,2>{{71,82},{115,126}} );
+  }
+  SUBCASE("strided_array") {
+    auto row_0 = make_strided_array(x,0,0); // fix axis 0 at index 0
+    auto row_2 = make_strided_array(x,0,2);
+    dyn_multi_array<int,1> a(4);
+    a = row_2 - row_0;
+    CHECK( a == dyn_multi_array<int,1>{8,8,8,8} );
+  }
+  SUBCASE("assign to a view") {
+    auto row_0 = make_strided_array(x,0,0);
+    assign(row_0,make_strided_array(x,0,1)*make_strided_array(x,0,2));
+    CHECK( x(0,0) == 45 );
+    CHECK( x(0,1) == 60 );
+    CHECK( x(0,3) == 96 );
+  }
+  SUBCASE("different layouts") {
+    std::vector<int> buf = {1,2,3,4,5,6,7,8,9,10,11,12};
+    c_multi_array_view<int,2> x_c(buf.data(),{3,4}); // same values as x
+    dyn_multi_array<int,2> a(3,4);
+    a = x - x_c;
+    CHECK( a == dyn_multi_array<int,2>(3,4) ); // zeros
+  }
+}
+
+TEST_CASE("multi_array expressions with padding") {
+  padded_multi_array<double,2> a(5,3);
+  padded_multi_array<double,2> b(5,3);
+  padded_multi_array<double,2> c(5,3);
+  for (int j=0; j<3; ++j) {
+    for (int i=0; i<5; ++i) {
+      b(i,j) = i;
+      c(i,j) = 10*j;
+    }
+  }
+  std::fill(a.data(),a.data()+a.memory_size(),-1.);
+  a = b + c; // linear loop, by column
+  CHECK( a(4,2) == 24. );
+  CHECK( a(0,1) == 10. );
+  CHECK( a.data()[5] == -1. ); // padding not written
+
+  dyn_multi_array<double,2> d(5,3);
+  d = a - c; // different strides: loop over the multi-indices
+  CHECK( d(4,2) == 4. );
+
+  SUBCASE("operand ending at its last element") {
+    // same strides as `a`, but no padding after the last element
+    std::vector<double> buf(2*8+5,1.);
+    dyn_shape<int,2,strided_layout> sh({5,3},{0,0},{1,8});
+    strided_multi_array_view<double,2> v(make_span(buf.data(),buf.size()),sh);
+    a = b + v;
+    CHECK( a(4,2) == 5. );
+    CHECK( a(0,0) == 1. );
+  }
+}
@@ -1,6 +1,7 @@
 #include "std_e/unit_test/doctest.hpp"
 #include "std_e/multi_array/multi_array/multi_array_types.hpp"
 #include "std_e/multi_index/multi_index_range.hpp"
+#include <cstdint>
 
 
 using namespace std;
@@ -267,3 +268,132 @@ TEST_CASE("make_span") {
   }
 }
 // [Sphinx Doc] make_span }
+
+
+TEST_CASE("multi_array layouts") {
+  // row-major buffer, e.g. from numpy
+  std::vector<int> buf = {
+    1,2,3,
+    4,5,6
+  };
+
+  SUBCASE("c_multi_array_view") {
+    c_multi_array_view<int,2> ma(buf.data(),{2,3});
+
+    CHECK( ma.strides() == multi_index<int,2>{3,1} );
+    CHECK( ma(0,0) == 1 ); CHECK( ma(0,1) == 2 ); CHECK( ma(0,2) == 3 );
+    CHECK( ma(1,0) == 4 ); CHECK( ma(1,1) == 5 ); CHECK( ma(1,2) == 6 );
+
+    ma(1,0) = 40;
+    CHECK( buf[3] == 40 ); // no copy
+  }
+  SUBCASE("c_multi_array_view from initializer lists") {
+    std::vector<int> buf_c(6);
+    c_multi_array_view<int,2> ma({{1,2,3},{4,5,6}},buf_c.data());
+    CHECK( buf_c == buf ); // row-major
+  }
+  SUBCASE("strided_multi_array_view") {
+    // the transpose of the row-major 2x3 array, seen as a 3x2 array
+    dyn_shape<int,2,strided_layout> sh({3,2},{0,0},{1,3});
+    strided_multi_array_view<int,2> ma(make_span(buf.data(),buf.size()),sh);
+
+    CHECK( ma(0,0) == 1 ); CHECK( ma(1,0) == 2 ); CHECK( ma(2,0) == 3 );
+    CHECK( ma(0,1) == 4 ); CHECK( ma(1,1) == 5 ); CHECK( ma(2,1) == 6 );
+  }
+  SUBCASE("equality compares the elements, not the memory") {
+    c_multi_array_view<int,2> c(buf.data(),{2,3});
+    dyn_multi_array<int,2> f = {{1,2,3},{4,5,6}}; // same elements, different memory order
+    dyn_multi_array<int,2> g(std::vector<int>{1,2,3,4,5,6},multi_index<int,2>{2,3}); // same memory, different elements
+    CHECK( c == f );
+    CHECK( c != g );
+    CHECK( f != g );
+
+    dyn_shape<int,2,strided_layout> sh({3,2},{0,0},{1,3});
+    strided_multi_array_view<int,2> t(make_span(buf.data(),buf.size()),sh);
+    dyn_multi_array<int,2> t_expected = {{1,4},{2,5},{3,6}};
+    CHECK( t == t_expected );
+    CHECK( t != c ); // not the same extent
+  }
+  SUBCASE("memory_order_multi_index_range") {
+    c_multi_array_view<int,2> ma(buf.data(),{2,3});
+    std::vector<int> elts;
+    for (const auto& is : memory_order_multi_index_range(ma.shape())) {
+      elts.push_back(ma(is));
+    }
+    CHECK( elts == buf );
+
+    dyn_shape<int,2,strided_layout> sh({3,2},{0,0},{1,3});
+    strided_multi_array_view<int,2> ma_t(make_span(buf.data(),buf.size()),sh);
+    elts.clear();
+    for (const auto& is : memory_order_multi_index_range(ma_t.shape())) {
+      elts.push_back(ma_t(is));
+    }
+    CHECK( elts == buf );
+  }
+}
+
+TEST_CASE("aligned and padded multi_arrays") {
+  auto is_aligned = [](const void* p){ return reinterpret_cast<std::uintptr_t>(p)%64 == 0; };
+
+  SUBCASE("aligned_multi_array") {
+    aligned_multi_array<double,2> ma(3,5);
+    CHECK( is_aligned(ma.data()) );
+    CHECK( ma.strides() == multi_index<int,2>{1,3} );
+    CHECK( ma.memory_size() == 15 );
+  }
+  SUBCASE("padded_multi_array") {
+    padded_multi_array<float,3> ma(5,3,2); // 16 floats by 64 bytes
+    CHECK( ma.size() == 5*3*2 );
+    CHECK( ma.strides() == multi_index<int,3>{1,16,16*3} );
+    CHECK( ma.memory_size() == 16*3*2 );
+    CHECK( ma.underlying_range().size() == 16*3*2 );
+
+    for (int k=0; k<2; ++k) {
+      for (int j=0; j<3; ++j) {
+        CHECK( is_aligned(&ma(0,j,k)) ); // each column is aligned
+        for (int i=0; i<5; ++i) {
+          ma(i,j,k) = i + 10*j + 100*k;
+        }
+      }
+    }
+    CHECK( ma(4,2,1) == 124 );
+    CHECK( ma.data()[1*16*3 + 2*16 + 4] == 124 );
+  }
+  SUBCASE("padded_multi_array from initializer lists") {
+    padded_multi_array<double,2> ma = {
+      {1.,2.,3.},
+      {4.,5.,6.}
+    };
+    CHECK( ma.memory_size() == 8*3 );
+    CHECK( ma.underlying_range().size() == 8*3 );
+    CHECK( ma(0,0) == 1. ); CHECK( ma(0,1) == 2. ); CHECK( ma(0,2) == 3. );
+    CHECK( ma(1,0) == 4. ); CHECK( ma(1,1) == 5. ); CHECK( ma(1,2) == 6. );
+    CHECK( ma.data()[2*8+1] == 6. );
+
+    padded_multi_array<double,1> v = {1.,2.,3.};
+    CHECK( v.underlying_range().size() == 8 );
+    CHECK( v(2) == 3. );
+  }
+  SUBCASE("padded_multi_array equality") {
+    padded_multi_array<int,2> p(5,3);
+    padded_multi_array<int,2> q(5,3);
+    std::fill(p.data(),p.data()+p.memory_size(),0);
+    std::fill(q.data(),q.data()+q.memory_size(),1); // different padding
+    dyn_multi_array<int,2> d(5,3);
+    for (int j=0; j<3; ++j) {
+      for (int i=0; i<5; ++i) {
+        p(i,j) = q(i,j) = d(i,j) = i+10*j;
+      }
+    }
+    CHECK( p == q );
+    CHECK( p == d );
+
+    q(4,2) = -1; // last element: beyond the first `size()` memory slots
+    CHECK( p != q );
+  }
+  SUBCASE("padded rank 1") {
+    padded_multi_array<double,1> ma(11); // 8 doubles by 64 bytes
+    CHECK( ma.size() == 11 );
+    CHECK( ma.memory_size() == 16 );
+  }
+}
@@ -0,0 +1,149 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/multi_array/multi_array/reduction.hpp"
+#include "std_e/multi_array/multi_array.hpp"
+
+using namespace std_e;
+
+
+TEST_CASE("multi_array full reductions") {
+  dyn_multi_array<int,2> x = {
+    {1, 2,3, 4},
+    {5,-6,7, 8},
+    {9,10,0,12}
+  };
+
+  SUBCASE("multi_array") {
+    CHECK( sum(x) == 55 );
+    CHECK( prod(make_block_view(x,multi_index<int,2>{0,0},multi_index<int,2>{2,2})) == 1*2*5*(-6) );
+    CHECK( min_value(x) == -6 );
+    CHECK( max_value(x) == 12 );
+    CHECK( argmin(x) == multi_index<int,2>{1,1} );
+    CHECK( argmax(x) == multi_index<int,2>{2,3} );
+    auto max_abs = [](int a, int b){ return std::max(std::abs(a),std::abs(b)); };
+    CHECK( reduce(x,0,max_abs) == 12 );
+    CHECK( reduce(make_strided_array(x,0,0),0,operation_functor<operation_kind::bit_or>) == (1|2|3|4) );
+  }
+  SUBCASE("views") {
+    auto b = make_block_view(x,multi_index<int,2>{1,1},multi_index<int,2>{2,3});
+    CHECK( sum(b) == -6+7+8+10+0+12 );
+    CHECK( min_value(b) == -6 );
+    CHECK( argmax(b) == multi_index<int,2>{1,2} );
+
+    auto row_2 = make_strided_array(x,0,2);
+    CHECK( sum(row_2) == 31 );
+    CHECK( max_value(row_2) == 12 );
+    CHECK( argmin(row_2) == multi_index<int,1>{2} );
+  }
+  SUBCASE("empty") {
+    dyn_multi_array<int,2> e(0,3);
+    CHECK( sum(e) == 0 );
+    CHECK( prod(e) == 1 );
+  }
+}
+
+TEST_CASE("multi_array parallel full reductions") {
+  dyn_multi_array<double,3> x(13,7,11);
+  for (int k=0; k<11; ++k) {
+    for (int j=0; j<7; ++j) {
+      for (int i=0; i<13; ++i) {
+        x(i,j,k) = i + 0.5*j - 0.25*k;
+      }
+    }
+  }
+  double expected = sum(x);
+  parallel_policy pol = {4,64};
+
+  CHECK( sum(pol,x) == expected ); // exact: the values are multiples of 1/4
+  CHECK( min_value(pol,x) == -2.5 );
+  CHECK( max_value(pol,x) == 15. );
+
+  auto b = make_block_view(x,multi_index<int,3>{1,2,3},multi_index<int,3>{10,5,8});
+  CHECK( sum(pol,b) == sum(b) );
+
+  SUBCASE("deterministic order") {
+    for (double& v : x) v *= 0.1; // not exact anymore
+    expected = sum(x);
+    double s1 = sum(with_n_thread(pol,1),x,reduction_order::deterministic);
+    double s3 = sum(with_n_thread(pol,3),x,reduction_order::deterministic);
+    double s4 = sum(with_n_thread(pol,4),x,reduction_order::deterministic);
+    CHECK( s1 == s3 );
+    CHECK( s1 == s4 );
+    CHECK( std::abs(s1-expected) < 1e-9 );
+  }
+}
+
+TEST_CASE("multi_array reductions along an axis") {
+  dyn_multi_array<int,2> x = {
+    {1, 2,3, 4},
+    {5,-6,7, 8},
+    {9,10,0,12}
+  };
+
+  SUBCASE("contiguous axis") {
+    auto s = sum_axis(x,0);
+    CHECK( s == dyn_multi_array<int,1>{15,6,10,24} );
+  }
+  SUBCASE("other axis") {
+    CHECK( sum_axis(x,1) == dyn_multi_array<int,1>{10,14,31} );
+    CHECK( min_axis(x,1) == dyn_multi_array<int,1>{1,-6,0} );
+    CHECK( max_axis(x,1) == dyn_multi_array<int,1>{4,8,12} );
+    CHECK( prod_axis(x,1) == dyn_multi_array<int,1>{24,-1680,0} );
+  }
+  SUBCASE("view") {
+    auto b = make_block_view(x,multi_index<int,2>{1,1},multi_index<int,2>{2,3});
+    CHECK( sum_axis(b,0) == dyn_multi_array<int,1>{4,7,20} );
+    CHECK( sum_axis(b,1) == dyn_multi_array<int,1>{9,22} );
+  }
+  SUBCASE("rank 1") {
+    dyn_multi_array<int,1> y = {3,4,5};
+    auto s = sum_axis(y,0);
+    CHECK( s.rank() == 0 );
+    CHECK( s() == 12 );
+  }
+  SUBCASE("rank 3, parallel") {
+    dyn_multi_array<double,3> y(6,5,40);
+    for (int k=0; k<40; ++k) {
+      for (int j=0; j<5; ++j) {
+        for (int i=0; i<6; ++i) {
+          y(i,j,k) = i+10*j+100*k;
+        }
+      }
+    }
+    parallel_policy pol = {3,16};
+    for (int axis=0; axis<3; ++axis) {
+      auto s_seq = sum_axis(y,axis);
+      auto s_par = sum_axis(pol,y,axis);
+      CHECK( s_seq == s_par );
+    }
+    auto s1 = sum_axis(pol,y,1);
+    CHECK( s1.extent() == multi_index<int,2>{6,40} );
+    CHECK( s1(2,3) == 5*2 + 10*(0+1+2+3+4) + 5*100*3 );
+  }
+}
+
+TEST_CASE("multi_array reductions with an accumulator type different from the element type") {
+  // 2^24+1 is not representable as a float: the sum is only exact if accumulated in double
+  dyn_multi_array<float,2> x(4,5);
+  std::fill(x.data(),x.data()+x.size(),1.f);
+  x(0,0) = 16777216.f;
+  double expected = 16777216. + 19.;
+
+  SUBCASE("full reduction") {
+    double s = reduce(x,0.,std::plus<>{});
+    CHECK( s == expected );
+
+    parallel_policy pol = {4,2};
+    CHECK( reduce(pol,x,0.,std::plus<>{}) == expected );
+    CHECK( reduce(pol,x,0.,std::plus<>{},reduction_order::deterministic) == expected );
+  }
+  SUBCASE("along an axis") {
+    auto row_sums = reduce_axis(x,1,0.,std::plus<>{});
+    static_assert(std::is_same_v<typename decltype(row_sums)::value_type,double>);
+    CHECK( row_sums(0) == 16777216. + 4. );
+    CHECK( row_sums(3) == 5. );
+
+    auto col_sums = reduce_axis(parallel_policy{4,1},x,0,0.,std::plus<>{});
+    CHECK( col_sums(0) == 16777216. + 3. );
+    CHECK( col_sums(4) == 4. );
+  }
+}
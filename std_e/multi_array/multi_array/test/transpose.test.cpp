@@ -0,0 +1,116 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/multi_array/multi_array/transpose.hpp"
+#include "std_e/multi_array/multi_array.hpp"
+#include "std_e/multi_index/multi_index_range.hpp"
+
+using namespace std_e;
+
+
+namespace {
+
+template<class T, int rank> auto
+make_iota_array(const multi_index<int,rank>& dims) {
+  dyn_multi_array<T,rank> x(dims);
+  for (int i=0; i<(int)x.size(); ++i) {
+    x.data()[i] = T(i);
+  }
+  return x;
+}
+
+template<class Multi_array_0, class Multi_array_1, class Multi_index> auto
+is_permuted_copy(const Multi_array_0& src, const Multi_array_1& dst, const Multi_index& axes) -> bool {
+  for (const auto& is : fortran_multi_index_range(dst.extent())) {
+    auto js = is;
+    for (int k=0; k<(int)is.size(); ++k) {
+      js[axes[k]] = is[k];
+    }
+    if (dst(is)!=src(js)) return false;
+  }
+  return true;
+}
+
+} // anonymous
+
+
+TEST_CASE("transpose_copy") {
+  SUBCASE("small") {
+    dyn_multi_array<int,2> x = {{1,2,3},{4,5,6}};
+    dyn_multi_array<int,2> y(3,2);
+    transpose_copy(x,y);
+    CHECK( y == dyn_multi_array<int,2>{{1,4},{2,5},{3,6}} );
+  }
+
+  // sizes that are not multiples of the SIMD blocks nor of the tiles
+  SUBCASE("32-bit elements") {
+    auto x = make_iota_array<float,2>({77,45});
+    dyn_multi_array<float,2> y(45,77);
+    transpose_copy(x,y);
+    CHECK( is_permuted_copy(x,y,multi_index<int,2>{1,0}) );
+  }
+  SUBCASE("64-bit elements") {
+    auto x = make_iota_array<double,2>({45,77});
+    dyn_multi_array<double,2> y(77,45);
+    transpose_copy(x,y);
+    CHECK( is_permuted_copy(x,y,multi_index<int,2>{1,0}) );
+  }
+  SUBCASE("other elements") {
+    auto x = make_iota_array<short,2>({33,70});
+    dyn_multi_array<short,2> y(70,33);
+    transpose_copy(x,y);
+    CHECK( is_permuted_copy(x,y,multi_index<int,2>{1,0}) );
+  }
+  SUBCASE("parallel") {
+    auto x = make_iota_array<int,2>({130,97});
+    dyn_multi_array<int,2> y(97,130);
+    transpose_copy(parallel_policy{4,64},x,y);
+    CHECK( is_permuted_copy(x,y,multi_index<int,2>{1,0}) );
+  }
+}
+
+TEST_CASE("permute_axes_copy") {
+  auto x = make_iota_array<int,3>({37,5,41});
+
+  SUBCASE("contiguous dimension kept") {
+    multi_index<int,3> axes = {0,2,1};
+    dyn_multi_array<int,3> y(37,41,5);
+    permute_axes_copy(x,y,axes);
+    CHECK( is_permuted_copy(x,y,axes) );
+  }
+  SUBCASE("contiguous dimension moved") {
+    multi_index<int,3> axes = {1,2,0};
+    dyn_multi_array<int,3> y(5,41,37);
+    permute_axes_copy(x,y,axes);
+    CHECK( is_permuted_copy(x,y,axes) );
+  }
+  SUBCASE("dynamic rank") {
+    auto x_dyn = make_iota_array<int,dynamic_size>({6,1,35,3});
+    multi_index<int> axes = {2,3,1,0};
+    dyn_multi_array<int,dynamic_size> y(35,3,1,6);
+    permute_axes_copy(x_dyn,y,axes);
+    CHECK( is_permuted_copy(x_dyn,y,axes) );
+  }
+  SUBCASE("parallel") {
+    multi_index<int,3> axes = {2,0,1};
+    dyn_multi_array<int,3> y(41,37,5);
+    permute_axes_copy(parallel_policy{3,16},x,y,axes);
+    CHECK( is_permuted_copy(x,y,axes) );
+  }
+  SUBCASE("to a c-ordered array") {
+    // same indices, so this is a change of layout from fortran to c order
+    std::vector<int> buf(x.size());
+    c_multi_array_view<int,3> y(buf.data(),{37,5,41});
+    permute_axes_copy(x,y,multi_index<int,3>{0,1,2});
+    CHECK( is_permuted_copy(x,y,multi_index<int,3>{0,1,2}) );
+    CHECK( buf[0] == x(0,0,0) );
+    CHECK( buf[1] == x(0,0,1) );
+  }
+}
+
+TEST_CASE("materialize permuted view") {
+  auto x = make_iota_array<int,3>({9,4,35});
+  auto v = reversed_indices_view(x);
+  dyn_multi_array<int,3> y(35,4,9);
+  materialize(v,y);
+  CHECK( is_permuted_copy(x,y,multi_index<int,3>{2,1,0}) );
+  CHECK( y(34,3,8) == v(34,3,8) );
+}
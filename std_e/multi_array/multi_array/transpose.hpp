@@ -0,0 +1,342 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#if defined(__SSE2__)
+  #include <immintrin.h>
+#endif
+#include "std_e/base/macros.hpp"
+#include "std_e/execution/execution.hpp"
+#include "std_e/multi_array/multi_array/multi_array_permuted_view.hpp"
+
+
+namespace std_e {
+
+
+/**
+  Copies of a multi_array into another one whose dimensions are a permutation of the first
+  (i.e. the materialization of a permuted view)
+  A naive loop over the destination reads the source with large strides: one cache line per element
+  Here, the two dimensions that are contiguous in the source and in the destination
+  are traversed by tiles, so that each cache line is used completely, both for reading and for writing:
+    - the 2D plane of these two dimensions is recursively cut in halves (cache-oblivious: no cache size is assumed)
+      down to tiles of at most `transpose_tile_size` x `transpose_tile_size` elements
+    - the tiles are transposed by 4x4 (32-bit types) or 2x2 (64-bit types) SSE2 blocks
+    - the other dimensions are looped over
+  Any layout (fortran, c, strided) is supported, since only strides are used
+*/
+constexpr std::ptrdiff_t transpose_tile_size = 32;
+
+
+// tile kernels {
+namespace detail {
+  template<class T> constexpr int simd_transpose_width =
+  #if defined(__SSE2__)
+    std::is_trivially_copyable_v<T> ? (sizeof(T)==4 ? 4 : sizeof(T)==8 ? 2 : 1) : 1;
+  #else
+    1;
+  #endif
+
+  #if defined(__SSE2__)
+    // dst[i + j*ld_dst] = src[i*ld_src + j] for 0<=i,j<4
+    template<class T> FORCE_INLINE auto
+    transpose_4x4(T* dst, std::ptrdiff_t ld_dst, const T* src, std::ptrdiff_t ld_src) -> void {
+      __m128 r0 = _mm_loadu_ps((const float*)(src         ));
+      __m128 r1 = _mm_loadu_ps((const float*)(src+  ld_src));
+      __m128 r2 = _mm_loadu_ps((const float*)(src+2*ld_src));
+      __m128 r3 = _mm_loadu_ps((const float*)(src+3*ld_src));
+      _MM_TRANSPOSE4_PS(r0,r1,r2,r3);
+      _mm_storeu_ps((float*)(dst         ),r0);
+      _mm_storeu_ps((float*)(dst+  ld_dst),r1);
+      _mm_storeu_ps((float*)(dst+2*ld_dst),r2);
+      _mm_storeu_ps((float*)(dst+3*ld_dst),r3);
+    }
+    // dst[i + j*ld_dst] = src[i*ld_src + j] for 0<=i,j<2
+    template<class T> FORCE_INLINE auto
+    transpose_2x2(T* dst, std::ptrdiff_t ld_dst, const T* src, std::ptrdiff_t ld_src) -> void {
+      __m128d r0 = _mm_loadu_pd((const double*)(src       ));
+      __m128d r1 = _mm_loadu_pd((const double*)(src+ld_src));
+      _mm_storeu_pd((double*)(dst       ),_mm_unpacklo_pd(r0,r1));
+      _mm_storeu_pd((double*)(dst+ld_dst),_mm_unpackhi_pd(r0,r1));
+    }
+  #endif
+
+  /// dst[i + j*ld_dst] = src[i*ld_src + j] for 0<=i<n_i, 0<=j<n_j
+  template<class T> auto
+  transpose_tile(T* dst, std::ptrdiff_t ld_dst, const T* src, std::ptrdiff_t ld_src, std::ptrdiff_t n_i, std::ptrdiff_t n_j) -> void {
+    using I = std::ptrdiff_t;
+    constexpr int W = simd_transpose_width<T>;
+    I i_simd = 0;
+    I j_simd = 0;
+    #if defined(__SSE2__)
+      if constexpr (W>1) {
+        i_simd = n_i - n_i%W;
+        j_simd = n_j - n_j%W;
+        for (I j=0; j<j_simd; j+=W) {
+          for (I i=0; i<i_simd; i+=W) {
+            if constexpr (W==4) transpose_4x4(dst+i+j*ld_dst,ld_dst,src+i*ld_src+j,ld_src);
+            else                transpose_2x2(dst+i+j*ld_dst,ld_dst,src+i*ld_src+j,ld_src);
+          }
+        }
+      }
+    #endif
+    for (I j=0; j<n_j; ++j) {
+      I i_start = j<j_simd ? i_simd : 0; // the SIMD blocks already did [0,i_simd) for these j
+      for (I i=i_start; i<n_i; ++i) {
+        dst[i+j*ld_dst] = src[i*ld_src+j];
+      }
+    }
+  }
+
+  /// dst[i*dst_si + j*dst_sj] = src[i*src_si + j*src_sj] for 0<=i<n_i, 0<=j<n_j
+  template<class T> auto
+  strided_tile(T* dst, std::ptrdiff_t dst_si, std::ptrdiff_t dst_sj, const T* src, std::ptrdiff_t src_si, std::ptrdiff_t src_sj, std::ptrdiff_t n_i, std::ptrdiff_t n_j) -> void {
+    if (dst_si==1 && src_sj==1) {
+      return transpose_tile(dst,dst_sj,src,src_si,n_i,n_j);
+    }
+    for (std::ptrdiff_t j=0; j<n_j; ++j) {
+      for (std::ptrdiff_t i=0; i<n_i; ++i) {
+        dst[i*dst_si+j*dst_sj] = src[i*src_si+j*src_sj];
+      }
+    }
+  }
+
+  /// Same as strided_tile, for any n_i and n_j: the larger dimension is cut in two until the pieces are tiles
+  /// The cut is done at a multiple of 4 so that the SIMD blocks are not split
+  template<class T> auto
+  transpose_recursive(T* dst, std::ptrdiff_t dst_si, std::ptrdiff_t dst_sj, const T* src, std::ptrdiff_t src_si, std::ptrdiff_t src_sj, std::ptrdiff_t n_i, std::ptrdiff_t n_j) -> void {
+    if (n_i<=transpose_tile_size && n_j<=transpose_tile_size) {
+      return strided_tile(dst,dst_si,dst_sj,src,src_si,src_sj,n_i,n_j);
+    }
+    if (n_i>=n_j) {
+      std::ptrdiff_t h = (n_i/2+3)/4*4;
+      transpose_recursive(dst         ,dst_si,dst_sj,src         ,src_si,src_sj,  h,n_j);
+      transpose_recursive(dst+h*dst_si,dst_si,dst_sj,src+h*src_si,src_si,src_sj,n_i-h,n_j);
+    } else {
+      std::ptrdiff_t h = (n_j/2+3)/4*4;
+      transpose_recursive(dst         ,dst_si,dst_sj,src         ,src_si,src_sj,n_i,  h);
+      transpose_recursive(dst+h*dst_sj,dst_si,dst_sj,src+h*src_sj,src_si,src_sj,n_i,n_j-h);
+    }
+  }
+}
+// tile kernels }
+
+
+// strided copy {
+namespace detail {
+  /// dst[sum_k is[k]*dst_strides[k]] = src[sum_k is[k]*src_strides[k]] for all `is` in the box `extent`
+  /// Dimensions of extent 1 are removed, and dimensions `k0`,`k1` are merged if `k1` follows `k0` in memory,
+  /// both in dst and src (e.g. a contiguous array is just one dimension)
+  /// The remaining dimensions are sorted by increasing dst stride
+  /// Returns false if the box is empty
+  inline auto
+  merge_contiguous_dims(std::vector<std::ptrdiff_t>& extent, std::vector<std::ptrdiff_t>& dst_strides, std::vector<std::ptrdiff_t>& src_strides) -> bool {
+    using I = std::ptrdiff_t;
+    int rank = extent.size();
+    std::vector<int> dims;
+    for (int k=0; k<rank; ++k) {
+      if (extent[k]==0) return false;
+      if (extent[k]>1) dims.push_back(k);
+    }
+    std::stable_sort(begin(dims),end(dims),[&dst_strides](int k0, int k1){ return std::abs(dst_strides[k0])<std::abs(dst_strides[k1]); });
+
+    std::vector<I> ext, ds, ss;
+    for (int k : dims) {
+      if (!ext.empty() && ds.back()*ext.back()==dst_strides[k] && ss.back()*ext.back()==src_strides[k]) {
+        ext.back() *= extent[k];
+      } else {
+        ext.push_back(extent[k]);
+        ds.push_back(dst_strides[k]);
+        ss.push_back(src_strides[k]);
+      }
+    }
+    extent = std::move(ext);
+    dst_strides = std::move(ds);
+    src_strides = std::move(ss);
+    return true;
+  }
+
+  /// dst[sum_k is[k]*dst_strides[k]] = src[sum_k is[k]*src_strides[k]] for all `is` in the box `extent`
+  template<class T> auto
+  strided_copy(sequential_policy, T* dst, const T* src, std::vector<std::ptrdiff_t> extent, std::vector<std::ptrdiff_t> dst_strides, std::vector<std::ptrdiff_t> src_strides) -> void {
+    using I = std::ptrdiff_t;
+    if (!merge_contiguous_dims(extent,dst_strides,src_strides)) return;
+    int rank = extent.size();
+    if (rank==0) {
+      *dst = *src;
+      return;
+    }
+
+    auto by_stride = [](const std::vector<I>& strides){ return [&strides](int k0, int k1){ return std::abs(strides[k0])<std::abs(strides[k1]); }; };
+    std::vector<int> dims(rank);
+    std::iota(begin(dims),end(dims),0);
+    int d_dim = 0; // most contiguous in dst (the dimensions are sorted by dst stride)
+    int s_dim = *std::min_element(begin(dims),end(dims),by_stride(src_strides)); // most contiguous in src
+
+    auto copy_inner = [&](T* d, const T* s){
+      if (d_dim==s_dim) {
+        I n = extent[d_dim];
+        I ds = dst_strides[d_dim];
+        I ss = src_strides[d_dim];
+        if (ds==1 && ss==1) {
+          std::copy_n(s,n,d);
+        } else {
+          for (I i=0; i<n; ++i) d[i*ds] = s[i*ss];
+        }
+      } else {
+        transpose_recursive(d,dst_strides[d_dim],dst_strides[s_dim],s,src_strides[d_dim],src_strides[s_dim],extent[d_dim],extent[s_dim]);
+      }
+    };
+
+    // the other dimensions are looped over, the fastest varying being the most contiguous in dst
+    std::vector<int> outer_dims;
+    std::copy_if(begin(dims),end(dims),std::back_inserter(outer_dims),[=](int k){ return k!=d_dim && k!=s_dim; });
+    int n_outer = outer_dims.size();
+
+    std::vector<I> is(n_outer,0);
+    while (true) {
+      copy_inner(dst,src);
+      int k = 0;
+      for (; k<n_outer; ++k) {
+        int dim = outer_dims[k];
+        ++is[k];
+        dst += dst_strides[dim];
+        src += src_strides[dim];
+        if (is[k]<extent[dim]) break;
+        dst -= extent[dim]*dst_strides[dim];
+        src -= extent[dim]*src_strides[dim];
+        is[k] = 0;
+      }
+      if (k==n_outer) return;
+    }
+  }
+
+  /// The dimension of dst with the largest stride is split into chunks, one per thread:
+  /// each thread writes to a contiguous part of dst
+  template<class T> auto
+  strided_copy(const parallel_policy& pol, T* dst, const T* src, std::vector<std::ptrdiff_t> extent, std::vector<std::ptrdiff_t> dst_strides, std::vector<std::ptrdiff_t> src_strides) -> void {
+    using I = std::ptrdiff_t;
+    if (!merge_contiguous_dims(extent,dst_strides,src_strides)) return;
+    int rank = extent.size();
+    I n = std::accumulate(begin(extent),end(extent),I(1),std::multiplies<>{});
+    int n_chk = n_chunk(pol,n);
+    if (n_chk==1 || rank==0) {
+      return strided_copy(seq,dst,src,std::move(extent),std::move(dst_strides),std::move(src_strides));
+    }
+
+    int outer_dim = rank-1; // the dimensions are sorted by dst stride
+    n_chk = std::min(I(n_chk),extent[outer_dim]);
+    for_each_chunk(n_chk,extent[outer_dim],[&](int, I start, I finish){
+      std::vector<I> chunk_extent = extent;
+      chunk_extent[outer_dim] = finish-start;
+      strided_copy(seq,dst+start*dst_strides[outer_dim],src+start*src_strides[outer_dim],std::move(chunk_extent),dst_strides,src_strides);
+    });
+  }
+
+  template<class Multi_array_0, class Multi_array_1, class Multi_index, class Policy> auto
+  permute_axes_copy(const Policy& pol, const Multi_array_0& src, Multi_array_1& dst, const Multi_index& axes) -> void {
+    using I = std::ptrdiff_t;
+    int rank = dst.rank();
+    STD_E_ASSERT((int)src.rank()==rank);
+    STD_E_ASSERT((int)axes.size()==rank);
+
+    std::vector<I> extent(rank);
+    std::vector<I> dst_strides(rank);
+    std::vector<I> src_strides(rank);
+    for (int k=0; k<rank; ++k) {
+      STD_E_ASSERT(dst.extent(k)==src.extent(axes[k]));
+      extent[k] = dst.extent(k);
+      dst_strides[k] = dst.strides(k);
+      src_strides[k] = src.strides(axes[k]);
+    }
+    strided_copy(pol,dst.data()+dst.base_offset(),src.data()+src.base_offset(),extent,dst_strides,src_strides);
+  }
+
+  template<class Multi_index> auto
+  reversed_axes(int rank) -> Multi_index {
+    auto axes = make_zero_multi_index<Multi_index>(rank);
+    for (int k=0; k<rank; ++k) {
+      axes[k] = rank-1-k;
+    }
+    return axes;
+  }
+}
+// strided copy }
+
+
+// permute_axes_copy {
+/// dst(is) = src(js) where js[axes[k]] = is[k],
+/// i.e. dimension `k` of `dst` is dimension `axes[k]` of `src` (same convention as numpy.transpose)
+/// Precondition: dst.extent(k)==src.extent(axes[k])
+template<class Multi_array_0, class Multi_array_1, class Multi_index> auto
+permute_axes_copy(const Multi_array_0& src, Multi_array_1& dst, const Multi_index& axes) -> void {
+  detail::permute_axes_copy(seq,src,dst,axes);
+}
+template<class Multi_array_0, class Multi_array_1, class Multi_index> auto
+permute_axes_copy(const parallel_policy& pol, const Multi_array_0& src, Multi_array_1& dst, const Multi_index& axes) -> void {
+  detail::permute_axes_copy(pol,src,dst,axes);
+}
+
+/// dst(i0,...,in) = src(in,...,i0)
+/// For rank 2, this is the matrix transposition
+template<class Multi_array_0, class Multi_array_1> auto
+transpose_copy(const Multi_array_0& src, Multi_array_1& dst) -> void {
+  using multi_index_type = typename Multi_array_0::multi_index_type;
+  permute_axes_copy(src,dst,detail::reversed_axes<multi_index_type>(src.rank()));
+}
+template<class Multi_array_0, class Multi_array_1> auto
+transpose_copy(const parallel_policy& pol, const Multi_array_0& src, Multi_array_1& dst) -> void {
+  using multi_index_type = typename Multi_array_0::multi_index_type;
+  permute_axes_copy(pol,src,dst,detail::reversed_axes<multi_index_type>(src.rank()));
+}
+// permute_axes_copy }
+
+
+// materialize permuted views {
+namespace detail {
+  // the view is `v(is) = source(perm.permute(is))`, so with p = perm.permute(0,...,n-1),
+  // dimension p[k] of the view is dimension k of the source
+  template<class T_ptr, class Shape, class Permutation, class Multi_array, class Policy> auto
+  materialize(const Policy& pol, const multi_array_permuted_view<T_ptr,Shape,Permutation>& v, Multi_array& dst) -> void {
+    using I = std::ptrdiff_t;
+    using multi_index_type = typename Shape::multi_index_type;
+    const Shape& src_shape = *v.source_shape;
+    int rank = src_shape.rank();
+    STD_E_ASSERT((int)dst.rank()==rank);
+
+    auto iota = make_zero_multi_index<multi_index_type>(rank);
+    std::iota(begin(iota),end(iota),0);
+    multi_index_type p = v.permute(iota);
+
+    std::vector<I> extent(rank);
+    std::vector<I> dst_strides(rank);
+    std::vector<I> src_strides(rank);
+    for (int k=0; k<rank; ++k) {
+      STD_E_ASSERT(dst.extent(p[k])==src_shape.extent(k));
+      extent[p[k]] = src_shape.extent(k);
+      dst_strides[p[k]] = dst.strides(p[k]);
+      src_strides[p[k]] = src_shape.strides(k);
+    }
+    strided_copy(pol,dst.data()+dst.base_offset(),v.ptr+src_shape.base_offset(),extent,dst_strides,src_strides);
+  }
+}
+
+/// dst(is) = v(is) for all `is`
+template<class T_ptr, class Shape, class Permutation, class Multi_array> auto
+materialize(const multi_array_permuted_view<T_ptr,Shape,Permutation>& v, Multi_array& dst) -> void {
+  detail::materialize(seq,v,dst);
+}
+template<class T_ptr, class Shape, class Permutation, class Multi_array> auto
+materialize(const parallel_policy& pol, const multi_array_permuted_view<T_ptr,Shape,Permutation>& v, Multi_array& dst) -> void {
+  detail::materialize(pol,v,dst);
+}
+// materialize permuted views }
+
+
+} // std_e
@@ -3,6 +3,7 @@
 
 #include "std_e/multi_index/multi_index.hpp"
 #include "std_e/multi_index/cartesian_product_size.hpp"
+#include "std_e/multi_array/shape/layout.hpp"
 #include "std_e/utils/array.hpp"
 #include "std_e/utils/vector.hpp"
 #include "std_e/base/dynamic_size.hpp"
@@ -11,11 +12,18 @@
 namespace std_e {
 
 
-template<class Integer, int N>
+/**
+  Extent and offset of a multi-dimensional array, with a memory layout (see layout.hpp)
+  The strides and the linear index of the first element (`base_offset`) are cached,
+  so that `linear_index` is a dot product. Hence, the extent and offset can't be modified in place:
+  a new shape has to be assigned instead
+*/
+template<class Integer, int N, class Layout = fortran_layout>
 class dyn_shape_base {
   public:
   // type traits
     using index_type = Integer;
+    using layout_type = Layout;
     static constexpr int ct_rank = N; // ct: compile-time
     static constexpr int ct_size = dynamic_size;
 
@@ -29,23 +37,47 @@ class dyn_shape_base {
     dyn_shape_base(Multi_index ext, Multi_index off)
       : extent_(convert_to<multi_index_type>(std::move(ext)))
       , offset_(convert_to<multi_index_type>(std::move(off)))
+      , strides_(Layout::strides(extent_))
+      , base_offset_(Layout::linear_index(strides_,index_type(0),offset_))
     {
       STD_E_ASSERT(extent().size()==offset().size());
     }
+    /// explicit strides: only for strided_layout
+    template<class Multi_index = multi_index_type> FORCE_INLINE constexpr
+    dyn_shape_base(Multi_index ext, Multi_index off, Multi_index strides)
+      : extent_(convert_to<multi_index_type>(std::move(ext)))
+      , offset_(convert_to<multi_index_type>(std::move(off)))
+      , strides_(convert_to<multi_index_type>(std::move(strides)))
+      , base_offset_(Layout::linear_index(strides_,index_type(0),offset_))
+    {
+      static_assert(std::is_same_v<Layout,strided_layout>,"dyn_shape: strides can only be given with a strided_layout");
+      STD_E_ASSERT(extent().size()==offset().size());
+      STD_E_ASSERT(extent().size()==this->strides().size());
+    }
     template<class Multi_index = multi_index_type> FORCE_INLINE constexpr
     dyn_shape_base(Multi_index ext)
       : extent_(convert_to<multi_index_type>(std::move(ext)))
       , offset_(make_zero_multi_index<multi_index_type>(extent_.size()))
+      , strides_(Layout::strides(extent_))
+      , base_offset_(0)
     {}
     FORCE_INLINE constexpr
     dyn_shape_base(std::initializer_list<index_type> ext)
       : extent_(convert_to<multi_index_type>(ext))
       , offset_(make_zero_multi_index<multi_index_type>(extent_.size()))
+      , strides_(Layout::strides(extent_))
+      , base_offset_(0)
     {}
     FORCE_INLINE constexpr
     dyn_shape_base(std::initializer_list<index_type> ext, std::initializer_list<index_type> off)
       : extent_(convert_to<multi_index_type>(ext))
       , offset_(convert_to<multi_index_type>(off))
+      , strides_(Layout::strides(extent_))
+      , base_offset_(Layout::linear_index(strides_,index_type(0),offset_))
+    {}
+    FORCE_INLINE constexpr
+    dyn_shape_base(std::initializer_list<index_type> ext, std::initializer_list<index_type> off, std::initializer_list<index_type> strides)
+      : dyn_shape_base(convert_to<multi_index_type>(ext),convert_to<multi_index_type>(off),convert_to<multi_index_type>(strides))
     {}
 
   // accessors
@@ -53,6 +85,11 @@ class dyn_shape_base {
     size() const -> index_type {
       return cartesian_product_size(this->extent());
     }
+    /// number of elements of the underlying memory (more than `size()` if the layout is padded)
+    FORCE_INLINE constexpr auto
+    memory_size() const -> index_type {
+      return Layout::memory_size(extent_,strides_);
+    }
 
     FORCE_INLINE constexpr auto
     extent() const -> const multi_index_type& {
@@ -72,32 +109,36 @@ class dyn_shape_base {
     }
 
     FORCE_INLINE constexpr auto
-    extent() -> multi_index_type& {
-      return extent_;
-    }
-    FORCE_INLINE constexpr auto
-    offset() -> multi_index_type& {
-      return offset_;
+    strides() const -> const multi_index_type& {
+      return strides_;
     }
     FORCE_INLINE auto
-    extent(int i) -> index_type& {
-      return extent()[i];
+    strides(int i) const -> index_type {
+      return strides()[i];
     }
-    FORCE_INLINE auto
-    offset(int i) -> index_type& {
-      return offset()[i];
+    FORCE_INLINE constexpr auto
+    base_offset() const -> index_type {
+      return base_offset_;
+    }
+
+  // linear index
+    template<class Multi_index> FORCE_INLINE constexpr auto
+    linear_index(const Multi_index& indices) const -> index_type {
+      return Layout::linear_index(strides_,base_offset_,indices);
     }
   private:
     multi_index_type extent_;
     multi_index_type offset_;
+    multi_index_type strides_;
+    index_type base_offset_ = 0;
 };
 
 
-template<class Integer, int N>
-class dyn_shape : public dyn_shape_base<Integer,N> {
+template<class Integer, int N, class Layout = fortran_layout>
+class dyn_shape : public dyn_shape_base<Integer,N,Layout> {
   public:
   // ctors
-    using base = dyn_shape_base<Integer,N>;
+    using base = dyn_shape_base<Integer,N,Layout>;
     using base::base;
     FORCE_INLINE constexpr
     dyn_shape()
@@ -113,11 +154,11 @@ class dyn_shape : public dyn_shape_base<Integer,N> {
 
 
 
-template<class Integer>
-class dyn_shape<Integer,dynamic_size> : public dyn_shape_base<Integer,dynamic_size> {
+template<class Integer, class Layout>
+class dyn_shape<Integer,dynamic_size,Layout> : public dyn_shape_base<Integer,dynamic_size,Layout> {
   public:
   // ctors
-    using base = dyn_shape_base<Integer,dynamic_size>;
+    using base = dyn_shape_base<Integer,dynamic_size,Layout>;
     using base::base;
 
   // accessors
@@ -31,11 +31,11 @@ struct make_shape__impl<fixed_shape<dims...>> {
   }
 };
 
-template<class Integer, int N>
-struct make_shape__impl<dyn_shape<Integer,N>> {
+template<class Integer, int N, class Layout>
+struct make_shape__impl<dyn_shape<Integer,N,Layout>> {
   template<class Multi_index> FORCE_INLINE static constexpr auto
-  func(Multi_index&& ext, Multi_index&& off) -> dyn_shape<Integer,N> {
-    return dyn_shape<Integer,N>(FWD(ext),FWD(off));
+  func(Multi_index&& ext, Multi_index&& off) -> dyn_shape<Integer,N,Layout> {
+    return dyn_shape<Integer,N,Layout>(FWD(ext),FWD(off));
   }
 };
 
@@ -46,6 +46,13 @@ make_shape(Multi_index&& ext, Multi_index&& off) -> Shape {
 // make_shape }
 
 
+/// Batch conversion of multi-indices to linear indices, see `linear_indices_from_strides`
+template<class Multi_array_shape, class I> auto
+linear_indices(const Multi_array_shape& sh, const I* indices_by_dim, I n, I* out) -> void {
+  linear_indices_from_strides(sh.strides(),I(sh.base_offset()),indices_by_dim,n,out);
+}
+
+
 template<class Multi_array_shape, class Multi_index> auto
 shape_restriction_start_index_1d(const Multi_array_shape& x, const Multi_index& right_indices) {
   using index_type = index_type_of<Multi_index>;
@@ -4,6 +4,7 @@
 #include "std_e/multi_index/multi_index.hpp"
 #include "std_e/meta/index_sequence.hpp"
 #include "std_e/multi_index/cartesian_product_size.hpp"
+#include "std_e/multi_array/shape/layout.hpp"
 
 
 namespace std_e {
@@ -12,6 +13,7 @@ namespace std_e {
 template<int... dims>
 struct fixed_shape {
   using index_type = int;
+  using layout_type = fortran_layout;
   static constexpr int ct_rank = sizeof...(dims); // ct: compile-time
 
   using multi_index_type = multi_index<index_type,ct_rank>;
@@ -29,6 +31,10 @@ struct fixed_shape {
     return ct_size;
   }
   static FORCE_INLINE constexpr auto
+  memory_size() -> int {
+    return ct_size;
+  }
+  static FORCE_INLINE constexpr auto
   extent() -> const multi_index_type& {
     return fixed_extent;
   }
@@ -44,6 +50,25 @@ struct fixed_shape {
   offset(int i) -> index_type {
     return offset()[i];
   }
+
+  static constexpr multi_index_type fixed_strides = fortran_strides(fixed_extent);
+  static FORCE_INLINE constexpr auto
+  strides() -> const multi_index_type& {
+    return fixed_strides;
+  }
+  static FORCE_INLINE constexpr auto
+  strides(int i) -> index_type {
+    return strides()[i];
+  }
+  static FORCE_INLINE constexpr auto
+  base_offset() -> index_type {
+    return 0;
+  }
+
+  template<class Multi_index> static FORCE_INLINE constexpr auto
+  linear_index(const Multi_index& indices) -> index_type {
+    return layout_type::linear_index(fixed_strides,index_type(0),indices);
+  }
 };
 
 
@@ -0,0 +1,148 @@
+#pragma once
+
+
+#include "std_e/multi_index/fortran_order.hpp"
+#include "std_e/multi_index/multi_index_range.hpp"
+#include "std_e/multi_index/cartesian_product_size.hpp"
+#include <algorithm>
+#include <numeric>
+#include <cstdlib>
+
+
+namespace std_e {
+
+
+/**
+concept Layout
+  strides(extent) -> Multi_index            // strides used if they are not given explicitly
+  linear_index(strides,base_offset,indices) -> Integer
+  multi_index_range(extent,strides) -> range of multi-indices in memory order
+  memory_size(extent,strides) -> Integer    // number of elements to allocate
+
+Layouts of dyn_shape:
+  - fortran_layout: column-major, the first index is contiguous (the default)
+  - c_layout: row-major, the last index is contiguous (e.g. numpy and HDF5 buffers)
+  - strided_layout: arbitrary strides, given at construction (e.g. a view of a sub-array or of a transposed array)
+  - padded_layout<W>: column-major, with the first dimension padded to a multiple of W elements
+*/
+struct fortran_layout {
+  template<class Multi_index> static FORCE_INLINE constexpr auto
+  strides(const Multi_index& extent) -> Multi_index {
+    return fortran_strides(extent);
+  }
+  template<class Multi_index_0, class Multi_index_1, class I> static FORCE_INLINE constexpr auto
+  linear_index(const Multi_index_0& strides, I base_offset, const Multi_index_1& indices) -> I {
+    return linear_index_from_strides(strides,base_offset,indices);
+  }
+  template<class Multi_index> static constexpr auto
+  multi_index_range(const Multi_index& extent, const Multi_index& /*strides*/) {
+    return fortran_multi_index_range(extent);
+  }
+  template<class Multi_index> static constexpr auto
+  memory_size(const Multi_index& extent, const Multi_index& /*strides*/) {
+    return cartesian_product_size(extent);
+  }
+};
+
+struct c_layout {
+  template<class Multi_index> static FORCE_INLINE constexpr auto
+  strides(const Multi_index& extent) -> Multi_index {
+    return c_strides(extent);
+  }
+  template<class Multi_index_0, class Multi_index_1, class I> static FORCE_INLINE constexpr auto
+  linear_index(const Multi_index_0& strides, I base_offset, const Multi_index_1& indices) -> I {
+    return c_linear_index_from_strides(strides,base_offset,indices);
+  }
+  template<class Multi_index> static constexpr auto
+  multi_index_range(const Multi_index& extent, const Multi_index& /*strides*/) {
+    return c_multi_index_range(extent);
+  }
+  template<class Multi_index> static constexpr auto
+  memory_size(const Multi_index& extent, const Multi_index& /*strides*/) {
+    return cartesian_product_size(extent);
+  }
+};
+
+/// If no strides are given, they are the Fortran ones
+struct strided_layout {
+  template<class Multi_index> static FORCE_INLINE constexpr auto
+  strides(const Multi_index& extent) -> Multi_index {
+    return fortran_strides(extent);
+  }
+  template<class Multi_index_0, class Multi_index_1, class I> static FORCE_INLINE constexpr auto
+  linear_index(const Multi_index_0& strides, I base_offset, const Multi_index_1& indices) -> I {
+    return general_linear_index_from_strides(strides,base_offset,indices);
+  }
+  /// The fastest varying index is the one with the smallest stride
+  template<class Multi_index> static auto
+  multi_index_range(const Multi_index& extent, const Multi_index& strides) {
+    int rank = strides.size();
+    multi_index<int,rank_of<Multi_index>> order = make_array_of_size<multi_index<int,rank_of<Multi_index>>>(rank);
+    std::iota(begin(order),end(order),0);
+    std::stable_sort(begin(order),end(order),[&strides](int i, int j){ return std::abs(strides[i]) < std::abs(strides[j]); });
+    return multi_index_range_with_order(extent,order);
+  }
+  /// Span between the first and the last element
+  template<class Multi_index> static auto
+  memory_size(const Multi_index& extent, const Multi_index& strides) {
+    using I = std::decay_t<decltype(extent[0])>;
+    if (cartesian_product_size(extent)==0) return I(0);
+    I sz = 1;
+    for (size_t k=0; k<size_t(extent.size()); ++k) {
+      sz += (extent[k]-1)*std::abs(strides[k]);
+    }
+    return sz;
+  }
+};
+
+/**
+  Column-major layout where the first dimension is padded to a multiple of W elements:
+  if the base pointer is aligned on W elements (see `aligned_allocator`), then each column `x(0,j,k...)`
+  also is, so that the loops over the first index can be vectorized with aligned loads and without remainder loop
+  The padding is reflected in the strides and in `memory_size`, but not in the extent
+*/
+template<int W>
+struct padded_layout {
+  static_assert(W>0);
+  static constexpr int padding = W;
+
+  template<class Multi_index> static constexpr auto
+  strides(const Multi_index& extent) -> Multi_index {
+    Multi_index strides = fortran_strides(extent);
+    int rank = extent.size();
+    if (rank>1) {
+      strides[1] = (extent[0]+W-1)/W*W;
+      for (int k=2; k<rank; ++k) {
+        strides[k] = strides[k-1]*extent[k-1];
+      }
+    }
+    return strides;
+  }
+  template<class Multi_index_0, class Multi_index_1, class I> static FORCE_INLINE constexpr auto
+  linear_index(const Multi_index_0& strides, I base_offset, const Multi_index_1& indices) -> I {
+    return linear_index_from_strides(strides,base_offset,indices);
+  }
+  template<class Multi_index> static constexpr auto
+  multi_index_range(const Multi_index& extent, const Multi_index& /*strides*/) {
+    return fortran_multi_index_range(extent);
+  }
+  /// Includes the padding of the last column, so that it can be accessed by whole SIMD vectors
+  template<class Multi_index> static constexpr auto
+  memory_size(const Multi_index& extent, const Multi_index& strides) {
+    using I = std::decay_t<decltype(extent[0])>;
+    int rank = extent.size();
+    if (rank<=1) return I((cartesian_product_size(extent)+W-1)/W*W);
+    return I(strides[rank-1]*extent[rank-1]);
+  }
+};
+
+
+/// Multi-indices of `sh` in the order of its memory layout: accessing the elements in this order is cache-friendly
+template<class Multi_array_shape> constexpr auto
+memory_order_multi_index_range(const Multi_array_shape& sh) {
+  using layout_type = typename Multi_array_shape::layout_type;
+  return layout_type::multi_index_range(sh.extent(),sh.strides());
+}
+
+
+} // std_e
@@ -25,3 +25,22 @@ TEST_CASE("dyn_shape") {
   CHECK( sh.offset(2) == 2 );
 }
 // [Sphinx Doc] dyn_shape }
+
+TEST_CASE("dyn_shape strides and linear_index") {
+  dyn_shape<int,3> sh = {{10,20,30},{2,1,3}};
+
+  CHECK( sh.strides() == multi_index<int,3>{1,10,10*20} );
+  CHECK( sh.base_offset() == 2 + 1*10 + 3*10*20 );
+  CHECK( sh.linear_index(multi_index<int,3>{4,5,6}) == fortran_order_from_dimensions(sh.extent(),sh.offset(),multi_index<int,3>{4,5,6}) );
+
+  SUBCASE("dynamic rank") {
+    dyn_shape<int,dynamic_size> dsh = {{10,20,30},{2,1,3}};
+    CHECK( dsh.strides() == multi_index<int>{1,10,10*20} );
+    CHECK( dsh.linear_index(multi_index<int>{4,5,6}) == sh.linear_index(multi_index<int,3>{4,5,6}) );
+  }
+  SUBCASE("assigning a new shape updates the strides") {
+    sh = dyn_shape<int,3>(multi_index<int,3>{3,4,5});
+    CHECK( sh.strides() == multi_index<int,3>{1,3,12} );
+    CHECK( sh.base_offset() == 0 );
+  }
+}
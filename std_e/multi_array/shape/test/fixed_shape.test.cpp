@@ -36,3 +36,10 @@ TEST_CASE("fixed shape") {
   }
 }
 // [Sphinx Doc] fixed_shape }
+
+TEST_CASE("fixed shape linear_index") {
+  using fixed_shape_type = fixed_shape<5,4,3,2>;
+
+  static_assert( fixed_shape_type::strides(3) == 5*4*3 );
+  static_assert( fixed_shape_type::linear_index(multi_index<int,4>{1,2,0,1}) == 1 + 2*5 + 1*5*4*3 );
+}
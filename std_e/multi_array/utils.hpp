@@ -11,12 +11,11 @@
 namespace std_e {
 
 
-template<class Integer, int rank> inline auto
-reshape(dyn_shape<Integer,rank>& x, const multi_index<Integer,rank>& dims) {
-  using multi_index_type = typename dyn_shape<Integer,rank>::multi_index_type;
+template<class Integer, int rank, class Layout> inline auto
+reshape(dyn_shape<Integer,rank,Layout>& x, const multi_index<Integer,rank>& dims) {
+  using multi_index_type = typename dyn_shape<Integer,rank,Layout>::multi_index_type;
   STD_E_ASSERT(x.offset()==make_zero_multi_index<multi_index_type>(x.offset().size()));
-  x.extent() = dims;
-  x.offset() = make_zero_multi_index<multi_index_type>(dims.size());
+  x = dyn_shape<Integer,rank,Layout>(dims);
 }
 
 template<class Dynamic_container, class Integer> auto
@@ -31,8 +30,7 @@ resize_memory(span<T,N>& /*x*/, Integer /*n*/) -> void {
 template<class R, class Shape> auto
 reshape(multi_array<R,Shape>& x, const typename Shape::multi_index_type& dims) {
   reshape(x.shape(),dims);
-  auto total_size = std_e::cartesian_product_size(dims);
-  resize_memory(x.underlying_range(),total_size);
+  resize_memory(x.underlying_range(),x.memory_size());
 }
 
 
@@ -0,0 +1,106 @@
+#pragma once
+
+
+#include <utility>
+#include "std_e/multi_index/multi_index.hpp"
+#include "std_e/base/macros.hpp"
+
+
+namespace std_e {
+
+
+/**
+  for_each_multi_index(extent,f) calls f(is) for each multi-index `is` in [0,extent), in Fortran order (the first index varies fastest)
+  Same as
+      for (const auto& is : fortran_multi_index_range(extent)) f(is);
+  but the multi-indices are generated by nested loops instead of incrementing a multi-index with a carry loop
+    - if the rank is known at compile time, the `rank` nested loops are generated at compile time,
+      so that the innermost loop is a plain loop that the compiler can vectorize
+    - else, the carry is only done once for each row of the first dimension
+  for_each_multi_index<dims...>(f) is the same, with the extent also known at compile time (e.g. the one of a fixed_shape)
+*/
+
+
+namespace detail {
+  template<int dim, class Multi_index, class F> FORCE_INLINE constexpr auto
+  nested_loops(const Multi_index& first, const Multi_index& last, Multi_index& is, F& f) -> void {
+    if constexpr (dim<0) {
+      f(std::as_const(is));
+    } else {
+      for (is[dim]=first[dim]; is[dim]<last[dim]; ++is[dim]) {
+        nested_loops<dim-1>(first,last,is,f);
+      }
+    }
+  }
+
+  template<class Multi_index, class F, int dim, int... dims> FORCE_INLINE constexpr auto
+  nested_loops(Multi_index& is, F& f, std::integer_sequence<int,dim,dims...>) -> void {
+    constexpr int k = sizeof...(dims); // loop `k` is over dimension `k`, the outermost loop being over the last dimension
+    for (is[k]=0; is[k]<dim; ++is[k]) {
+      if constexpr (k==0) {
+        f(std::as_const(is));
+      } else {
+        nested_loops(is,f,std::integer_sequence<int,dims...>{});
+      }
+    }
+  }
+
+  template<int... Is, int... rev_Is> constexpr auto
+  reverse_int_seq(std::integer_sequence<int,Is...>, std::integer_sequence<int,rev_Is...>) {
+    constexpr int dims[] = {Is...};
+    return std::integer_sequence<int,dims[sizeof...(Is)-1-rev_Is]...>{};
+  }
+}
+
+
+/// f(is) for `is` in [first,last)
+template<class Multi_index, class F> constexpr auto
+for_each_multi_index(const Multi_index& first, const Multi_index& last, F&& f) -> void {
+  constexpr int ct_rank = rank_of<Multi_index>;
+  int rank = first.size();
+  for (int k=0; k<rank; ++k) {
+    if (first[k]>=last[k]) return; // empty
+  }
+
+  Multi_index is = first;
+  if constexpr (ct_rank!=dynamic_size) {
+    detail::nested_loops<ct_rank-1>(first,last,is,f);
+  } else {
+    if (rank==0) return f(std::as_const(is));
+    while (true) {
+      for (is[0]=first[0]; is[0]<last[0]; ++is[0]) {
+        f(std::as_const(is));
+      }
+      int k = 1;
+      for (; k<rank; ++k) {
+        if (++is[k]<last[k]) break;
+        is[k] = first[k];
+      }
+      if (k==rank) return;
+    }
+  }
+}
+
+/// f(is) for `is` in [0,extent)
+template<class Multi_index, class F> constexpr auto
+for_each_multi_index(const Multi_index& extent, F&& f) -> void {
+  auto first = make_zero_multi_index<Multi_index>(extent.size());
+  for_each_multi_index(first,extent,f);
+}
+
+/// f(is) for `is` in [0,{dims...})
+template<int... dims, class F> constexpr auto
+for_each_multi_index(F&& f) -> void {
+  constexpr int rank = sizeof...(dims);
+  multi_index<int,rank> is = {};
+  if constexpr (rank==0) {
+    f(std::as_const(is));
+  } else if constexpr (((dims>0) && ...)) {
+    // the outermost loop is over the last dimension
+    constexpr auto rev_dims = detail::reverse_int_seq(std::integer_sequence<int,dims...>{},std::make_integer_sequence<int,rank>{});
+    detail::nested_loops(is,f,rev_dims);
+  }
+}
+
+
+} // std_e
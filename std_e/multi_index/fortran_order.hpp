@@ -5,6 +5,8 @@
 #include "std_e/multi_index/concept.hpp"
 #include "std_e/multi_index/multi_index.hpp"
 #include "std_e/utils/array.hpp"
+#include "std_e/base/macros.hpp"
+#include <algorithm>
 // TODO RENAME file, test (offsets!)
 
 
@@ -146,4 +148,115 @@ fortran_order_from_strides2(const Multi_index_0& strides, const Multi_index_1& i
 }
 
 
+// strides including the first one {
+/// strides[0] = 1, strides[k] = dims[0]*...*dims[k-1]
+/// (same size as `dims`, contrary to fortran_strides_from_extent2)
+template<class Multi_index> FORCE_INLINE constexpr auto
+fortran_strides(const Multi_index& dims) -> Multi_index {
+  int rank = dims.size();
+  auto strides = make_array_of_size<Multi_index>(rank);
+  if (rank==0) return strides;
+  strides[0] = 1;
+  for (int k=1; k<rank; ++k) {
+    strides[k] = strides[k-1]*dims[k-1];
+  }
+  return strides;
+}
+
+/// Dot product of `strides` and `indices`, plus `base_offset`
+/// With strides = fortran_strides(dims) and base_offset = linear_index_from_strides(strides,0,offsets),
+/// this is the same as fortran_order_from_dimensions(dims,offsets,indices),
+/// but the multiplications do not depend on each other
+template<class Multi_index_0, class Multi_index_1, class I> FORCE_INLINE constexpr auto
+linear_index_from_strides(const Multi_index_0& strides, I base_offset, const Multi_index_1& indices) -> I {
+  STD_E_ASSERT(strides.size()==indices.size());
+  int rank = strides.size();
+  if constexpr (is_fixed_size_array<Multi_index_1>) {
+    // compile-time rank: else, the compiler may not see that the loop does not go past the end of small `indices`
+    rank = std::tuple_size_v<Multi_index_1>;
+  }
+  if (rank==0) return base_offset;
+  STD_E_ASSERT(strides[0]==1);
+  I res = base_offset + indices[0]; // * 1   (see fortran_order_from_strides)
+  for (int k=1; k<rank; ++k) {
+    res += indices[k] * strides[k];
+  }
+  return res;
+}
+
+/// strides[rank-1] = 1, strides[k] = dims[k+1]*...*dims[rank-1]
+template<class Multi_index> FORCE_INLINE constexpr auto
+c_strides(const Multi_index& dims) -> Multi_index {
+  int rank = dims.size();
+  auto strides = make_array_of_size<Multi_index>(rank);
+  if (rank==0) return strides;
+  strides[rank-1] = 1;
+  for (int k=rank-2; k>=0; --k) {
+    strides[k] = strides[k+1]*dims[k+1];
+  }
+  return strides;
+}
+/// Same as linear_index_from_strides, but the last stride is 1 instead of the first one
+template<class Multi_index_0, class Multi_index_1, class I> FORCE_INLINE constexpr auto
+c_linear_index_from_strides(const Multi_index_0& strides, I base_offset, const Multi_index_1& indices) -> I {
+  STD_E_ASSERT(strides.size()==indices.size());
+  int rank = strides.size();
+  if (rank==0) return base_offset;
+  STD_E_ASSERT(strides[rank-1]==1);
+  I res = base_offset + indices[rank-1];
+  for (int k=0; k<rank-1; ++k) {
+    res += indices[k] * strides[k];
+  }
+  return res;
+}
+/// Same as linear_index_from_strides, for any strides
+template<class Multi_index_0, class Multi_index_1, class I> FORCE_INLINE constexpr auto
+general_linear_index_from_strides(const Multi_index_0& strides, I base_offset, const Multi_index_1& indices) -> I {
+  STD_E_ASSERT(strides.size()==indices.size());
+  int rank = strides.size();
+  I res = base_offset;
+  for (int k=0; k<rank; ++k) {
+    res += indices[k] * strides[k];
+  }
+  return res;
+}
+
+/**
+  Batch version of linear_index_from_strides: converts `n` multi-indices into linear indices
+    - any strides (Fortran, C or general)
+    - the multi-indices are given dimension by dimension (structure of arrays):
+      the k-th index of the j-th multi-index is indices_by_dim[k*n+j]
+    - out[j] is the linear index of the j-th multi-index
+  The loops over the multi-indices are contiguous and vectorized by the compiler.
+  They are blocked so that the block of `out` stays in L1 cache while looping over the dimensions
+*/
+template<class Multi_index, class I> auto
+linear_indices_from_strides(const Multi_index& strides, I base_offset, const I* indices_by_dim, I n, I* RESTRICT out) -> void {
+  constexpr I block_size = 1024;
+  int rank = strides.size();
+  for (I start=0; start<n; start+=block_size) {
+    I finish = std::min(start+block_size,n);
+    I* RESTRICT o = out+start;
+    I m = finish-start;
+    if (rank==0) {
+      std::fill_n(o,m,base_offset);
+      continue;
+    }
+    const I* idx = indices_by_dim+start;
+    I stride_0 = strides[0];
+    for (I j=0; j<m; ++j) {
+      o[j] = base_offset + idx[j] * stride_0;
+    }
+    for (int k=1; k<rank; ++k) {
+      const I* idx_k = indices_by_dim + k*n + start;
+      I stride_k = strides[k];
+      for (I j=0; j<m; ++j) {
+        o[j] += idx_k[j] * stride_k;
+      }
+    }
+  }
+}
+// strides including the first one }
+
+
 } // std_e
@@ -0,0 +1,120 @@
+#pragma once
+
+
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include "std_e/multi_index/multi_index.hpp"
+#include "std_e/multi_index/for_each_multi_index.hpp"
+#include "std_e/interval/multi_interval.hpp"
+#include "std_e/execution/execution.hpp"
+
+
+namespace std_e {
+
+
+/**
+  Loops over the multi-indices of a multi_interval (or of an extent), sequentially or in parallel
+    - the multi-indices are visited in Fortran order (the first index varies fastest)
+    - f(is) is called for each multi-index `is`
+      (in parallel, `f` is called concurrently: it must be safe to do so)
+  Inside a tile, the multi-indices are generated by nested loops (see for_each_multi_index.hpp)
+
+  In parallel, the index space is partitioned into tiles, and the tiles are statically distributed among the threads
+  (each thread gets a contiguous range of tiles, in Fortran order of the tiles)
+  By default, the tiles have whole rows of the first dimensions, and span enough of the next dimension for each tile to have at least `grain_size` elements
+*/
+
+
+namespace detail {
+  /// whole first dimensions, then enough of the next one to reach `grain_size`, then 1
+  template<class Multi_index> auto
+  default_tile_extent(const Multi_index& extent, std::ptrdiff_t grain_size) -> Multi_index {
+    using I = index_type_of<Multi_index>;
+    int rank = extent.size();
+    auto tile = make_array_of_size<Multi_index>(rank);
+    std::ptrdiff_t tile_size = 1;
+    for (int k=0; k<rank; ++k) {
+      if (tile_size>=grain_size) {
+        tile[k] = 1;
+      } else {
+        std::ptrdiff_t e = std::max(I(extent[k]),I(1));
+        tile[k] = std::min(e,(grain_size+tile_size-1)/tile_size);
+        tile_size *= tile[k];
+      }
+    }
+    return tile;
+  }
+}
+
+
+// sequential {
+template<class I, int rk, class F> auto
+parallel_for(sequential_policy, const multi_interval<I,rk>& box, F f) -> void {
+  for_each_multi_index(box.first(),box.last(),f);
+}
+template<class I, int rk, class F> auto
+parallel_for(sequential_policy, const multi_index<I,rk>& extent, F f) -> void {
+  for_each_multi_index(extent,f);
+}
+// sequential }
+
+
+// parallel {
+/// Precondition: tile_extent[k] > 0
+template<class I, int rk, class F> auto
+parallel_for(const parallel_policy& pol, const multi_interval<I,rk>& box, const multi_index<I,rk>& tile_extent, F f) -> void {
+  using multi_index_type = multi_index<I,rk>;
+  int rank = box.rank();
+  STD_E_ASSERT((int)tile_extent.size()==rank);
+
+  auto n_tiles_by_dim = make_array_of_size<multi_index_type>(rank);
+  std::ptrdiff_t n_tile = 1;
+  std::ptrdiff_t n_elt = 1;
+  for (int k=0; k<rank; ++k) {
+    STD_E_ASSERT(tile_extent[k]>0);
+    I len = std::max(I(box.last()[k]-box.first()[k]),I(0));
+    n_tiles_by_dim[k] = (len+tile_extent[k]-1)/tile_extent[k];
+    n_tile *= n_tiles_by_dim[k];
+    n_elt *= len;
+  }
+  if (n_elt==0) return;
+
+  int n_chk = std::min(std::ptrdiff_t(n_chunk(pol,n_elt)),n_tile);
+  if (n_chk==1) {
+    return parallel_for(seq,box,f);
+  }
+
+  for_each_chunk(n_chk,n_tile,[&](int, std::ptrdiff_t start, std::ptrdiff_t finish){
+    auto tile_first = make_array_of_size<multi_index_type>(rank);
+    auto tile_last  = make_array_of_size<multi_index_type>(rank);
+    for (std::ptrdiff_t t=start; t<finish; ++t) {
+      std::ptrdiff_t rem = t;
+      for (int k=0; k<rank; ++k) { // tile multi-index, Fortran order
+        I i_tile = rem % n_tiles_by_dim[k];
+        rem /= n_tiles_by_dim[k];
+        tile_first[k] = box.first()[k] + i_tile*tile_extent[k];
+        tile_last [k] = std::min(I(tile_first[k]+tile_extent[k]),box.last()[k]);
+      }
+      for_each_multi_index(tile_first,tile_last,f);
+    }
+  });
+}
+template<class I, int rk, class F> auto
+parallel_for(const parallel_policy& pol, const multi_interval<I,rk>& box, F f) -> void {
+  auto len = make_array_of_size<multi_index<I,rk>>(box.rank());
+  for (int k=0; k<box.rank(); ++k) {
+    len[k] = std::max(I(box.last()[k]-box.first()[k]),I(0));
+  }
+  auto tile_extent = detail::default_tile_extent(len,pol.grain_size);
+  parallel_for(pol,box,tile_extent,std::move(f));
+}
+template<class I, int rk, class F> auto
+parallel_for(const parallel_policy& pol, const multi_index<I,rk>& extent, F f) -> void {
+  multi_interval<I,rk> box(make_zero_multi_index<multi_index<I,rk>>(extent.size()),extent);
+  parallel_for(pol,box,std::move(f));
+}
+// parallel }
+
+
+} // std_e
@@ -0,0 +1,55 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/multi_index/for_each_multi_index.hpp"
+#include "std_e/multi_index/multi_index_range.hpp"
+#include <vector>
+
+using namespace std_e;
+
+
+TEST_CASE("for_each_multi_index") {
+  SUBCASE("fixed rank") {
+    std::vector<multi_index<int,3>> visited;
+    for_each_multi_index(multi_index<int,3>{2,3,2},[&visited](const auto& is){ visited.push_back(is); });
+
+    std::vector<multi_index<int,3>> expected;
+    for (const auto& is : fortran_multi_index_range(multi_index<int,3>{2,3,2})) {
+      expected.push_back(is);
+    }
+    CHECK( visited == expected );
+  }
+  SUBCASE("dynamic rank") {
+    std::vector<multi_index<int>> visited;
+    for_each_multi_index(multi_index<int>{2,3,2},[&visited](const auto& is){ visited.push_back(is); });
+
+    std::vector<multi_index<int>> expected;
+    for (const auto& is : fortran_multi_index_range(multi_index<int>{2,3,2})) {
+      expected.push_back(is);
+    }
+    CHECK( visited == expected );
+  }
+  SUBCASE("compile-time extent") {
+    std::vector<multi_index<int,2>> visited;
+    for_each_multi_index<2,3>([&visited](const auto& is){ visited.push_back(is); });
+    CHECK( visited == std::vector<multi_index<int,2>>{{0,0},{1,0},{0,1},{1,1},{0,2},{1,2}} );
+  }
+  SUBCASE("sub-box") {
+    std::vector<multi_index<int,2>> visited;
+    for_each_multi_index(multi_index<int,2>{1,5},multi_index<int,2>{3,7},[&visited](const auto& is){ visited.push_back(is); });
+    CHECK( visited == std::vector<multi_index<int,2>>{{1,5},{2,5},{1,6},{2,6}} );
+  }
+  SUBCASE("rank 0 and empty") {
+    int n_call = 0;
+    auto count = [&n_call](const auto&){ ++n_call; };
+    for_each_multi_index(multi_index<int,0>{},count);
+    CHECK( n_call == 1 );
+    for_each_multi_index(multi_index<int>{},count);
+    CHECK( n_call == 2 );
+    for_each_multi_index<>(count);
+    CHECK( n_call == 3 );
+
+    for_each_multi_index(multi_index<int,2>{3,0},count);
+    for_each_multi_index(multi_index<int>{0,3},count);
+    for_each_multi_index<3,0>(count);
+    CHECK( n_call == 3 );
+  }
+}
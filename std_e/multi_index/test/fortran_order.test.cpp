@@ -43,3 +43,41 @@ TEST_CASE("fortran_order_from_strides") {
   CHECK( fortran_order_from_strides(strides,MI{1,0,0}) == 1 );
   CHECK( fortran_order_from_strides(strides,MI{1,2,3}) == 1 + 2*2 + 3*2*3 );
 }
+
+TEST_CASE("linear_index_from_strides") {
+  MI dims = {2,3,4};
+  MI offsets = {1,1,1};
+  MI strides = fortran_strides(dims);
+  CHECK( strides == MI{1,2,2*3} );
+
+  int base_offset = linear_index_from_strides(strides,0,offsets);
+  CHECK( base_offset == fortran_order_from_dimensions(dims, offsets, MI{0,0,0}) );
+  CHECK( linear_index_from_strides(strides,base_offset,MI{1,2,3}) == fortran_order_from_dimensions(dims, offsets, MI{1,2,3}) );
+
+  SUBCASE("batch") {
+    // multi-indices (0,0,0), (1,2,3), (1,0,2), (0,1,1), (-1,-1,-1), by dimension
+    std::vector<int> indices_by_dim = {
+      0, 1, 1, 0, -1,
+      0, 2, 0, 1, -1,
+      0, 3, 2, 1, -1
+    };
+    std::vector<int> res(5);
+    linear_indices_from_strides(strides,base_offset,indices_by_dim.data(),5,res.data());
+    CHECK( res == std::vector{
+      fortran_order_from_dimensions(dims, offsets, MI{0,0,0}),
+      fortran_order_from_dimensions(dims, offsets, MI{1,2,3}),
+      fortran_order_from_dimensions(dims, offsets, MI{1,0,2}),
+      fortran_order_from_dimensions(dims, offsets, MI{0,1,1}),
+      0
+    });
+  }
+}
+
+TEST_CASE("c_strides") {
+  MI dims = {2,3,4};
+  MI strides = c_strides(dims);
+  CHECK( strides == MI{3*4,4,1} );
+
+  CHECK( c_linear_index_from_strides(strides,0,MI{1,2,3}) == c_order_from_dimensions(dims, MI{0,0,0}, MI{1,2,3}) );
+  CHECK( general_linear_index_from_strides(strides,0,MI{1,2,3}) == c_order_from_dimensions(dims, MI{0,0,0}, MI{1,2,3}) );
+}
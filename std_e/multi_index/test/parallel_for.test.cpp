@@ -0,0 +1,52 @@
+#include "std_e/unit_test/doctest.hpp"
+#include "std_e/multi_index/parallel_for.hpp"
+#include <vector>
+
+using namespace std_e;
+
+
+TEST_CASE("parallel_for over a multi_interval") {
+  SUBCASE("sequential, Fortran order") {
+    multi_interval<int,2> box = {{1,10},{3,12}};
+    std::vector<multi_index<int,2>> visited;
+    parallel_for(seq,box,[&visited](const auto& is){ visited.push_back(is); });
+    CHECK( visited == std::vector<multi_index<int,2>>{{1,10},{2,10},{1,11},{2,11}} );
+  }
+  SUBCASE("sequential, dynamic rank") {
+    multi_interval<int> box = {{1,10,0},{3,12,2}};
+    std::vector<multi_index<int>> visited;
+    parallel_for(seq,box,[&visited](const auto& is){ visited.push_back(is); });
+    CHECK( visited.size() == 8 );
+    CHECK( visited[0] == multi_index<int>{1,10,0} );
+    CHECK( visited[1] == multi_index<int>{2,10,0} );
+    CHECK( visited[2] == multi_index<int>{1,11,0} );
+    CHECK( visited[7] == multi_index<int>{2,11,1} );
+  }
+  SUBCASE("empty") {
+    int n_call = 0;
+    parallel_for(seq,multi_interval<int,2>{{0,5},{4,5}},[&n_call](const auto&){ ++n_call; });
+    parallel_for(seq,multi_interval<int>{{0,5},{4,5}},[&n_call](const auto&){ ++n_call; });
+    CHECK( n_call == 0 );
+  }
+
+  SUBCASE("parallel, each multi-index visited once") {
+    int n_i = 7;
+    int n_j = 5;
+    int n_k = 9;
+    std::vector<int> n_visits(n_i*n_j*n_k,0);
+    auto visit = [&](const auto& is){ ++n_visits[is[0] + n_i*(is[1] + n_j*is[2])]; };
+
+    parallel_policy pol = {4,16};
+    SUBCASE("fixed rank") {
+      parallel_for(pol,multi_index<int,3>{n_i,n_j,n_k},visit);
+    }
+    SUBCASE("dynamic rank") {
+      parallel_for(pol,multi_index<int>{n_i,n_j,n_k},visit);
+    }
+    SUBCASE("explicit tiles") {
+      multi_interval<int,3> box = {{0,0,0},{n_i,n_j,n_k}};
+      parallel_for(pol,box,multi_index<int,3>{3,2,4},visit);
+    }
+    CHECK( n_visits == std::vector<int>(n_i*n_j*n_k,1) );
+  }
+}
@@ -74,7 +74,7 @@ GENERATE_BINARY_OPERATOR_OVERLOAD_SET( minus         , -  );
 GENERATE_BINARY_OPERATOR_OVERLOAD_SET( multiplies    , *  );
 GENERATE_BINARY_OPERATOR_OVERLOAD_SET( divides       , /  );
 GENERATE_BINARY_OPERATOR_OVERLOAD_SET( modulus       , %  );
-GENERATE_BINARY_OPERATOR_OVERLOAD_SET( negates       , -  );
+GENERATE_UNARY_OPERATOR_OVERLOAD_SET ( negates       , -  );
 ///// comparison
 GENERATE_BINARY_OPERATOR_OVERLOAD_SET( equal_to      , == );
 GENERATE_BINARY_OPERATOR_OVERLOAD_SET( not_equal_to  , != );
@@ -0,0 +1,29 @@
+#include "std_e/benchmark/benchmark.hpp"
+#include "std_e/parallel/serialize.hpp"
+
+using namespace std_e;
+
+
+namespace {
+
+
+STD_E_BENCHMARK("serialize_array/trivial", 1<<10, 1<<16, 1<<20) {
+  std::vector<double> x(state.size(),1.);
+
+  state.run([&](){
+    auto serial = serialize_array(x);
+    do_not_optimize(serial);
+  });
+}
+
+STD_E_BENCHMARK("serialize_array/vector_of_vectors", 1<<10, 1<<14, 1<<18) {
+  std::vector<std::vector<int>> x(state.size(),std::vector<int>{0,1,2,3});
+
+  state.run([&](){
+    auto serial = serialize_array(x);
+    do_not_optimize(serial);
+  });
+}
+
+
+} // anonymous
@@ -20,8 +20,7 @@ class frozen_flat_map {
       , values(std::move(vs))
     {
       auto perm = std_e::sort_permutation(keys);
-      permute(keys,perm);
-      permute(values,perm);
+      permutation_plan(perm).apply(keys,values);
     }
 
     constexpr auto
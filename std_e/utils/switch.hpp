@@ -41,25 +41,25 @@ struct switch_<std::integer_sequence<Integer,Is...>> {
 
     template<class fun_wrap_type, Integer I> using tagged_caller =
       typename fun_wrap_type::template tagged_caller<std::integral_constant<Integer,I>>;
+
+    // one table per function type, built at compile time
+    template<class fun_wrap_type> static constexpr auto lookup_table =
+      make_array( &tagged_caller<fun_wrap_type,Is>::call... );
   // ctor
     constexpr
     switch_(Integer i)
-      : i(i)
+      : index_of_i(position_in_seq(i,dispatching_indices))
     {
-      if (!(contains(i,dispatching_indices))) { throw case_is_not_available_error(); }
+      if (index_of_i==sizeof...(Is)) { throw case_is_not_available_error(); }
     }
 
     template<class F, class... Args> constexpr auto
     apply(F&& f, Args&&... args) {
       using function_wrapper_type = detail::function_wrapper<F,Args...>;
-
-      auto lookup_table = make_array( &tagged_caller<function_wrapper_type,Is>::call... );
-
-      auto index_of_i = position_in_seq(i,dispatching_indices);
-      return lookup_table[index_of_i](std::forward<F>(f),std::forward<Args>(args)...);
+      return lookup_table<function_wrapper_type>[index_of_i](std::forward<F>(f),std::forward<Args>(args)...);
     }
   private:
-    Integer i;
+    int index_of_i;
 };
 
 
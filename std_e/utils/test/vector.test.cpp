@@ -18,6 +18,15 @@ TEST_CASE("sort_unique(vector)") {
   std::vector<int> expected_v = {1,3,4,7,8,9};
   CHECK( v == expected_v );
 }
+TEST_CASE("sort_unique(vector) parallel") {
+  std::vector<int> v = {9,1,1,4,3,1,9,8,4,7,1,1,1,1,1,9};
+
+  std_e::parallel_policy pol = {3,2};
+  std_e::sort_unique(pol,v);
+
+  std::vector<int> expected_v = {1,3,4,7,8,9};
+  CHECK( v == expected_v );
+}
 TEST_CASE("sort_unique_permutation(vector)") {
   std::vector<int> v = {9,1,1,4,3,1,9,8,4,7};
 
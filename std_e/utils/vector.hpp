@@ -7,6 +7,7 @@
 #include "std_e/utils/to_string_fwd.hpp"
 #include "std_e/algorithm/permutation.hpp"
 #include "std_e/algorithm/unique_compress.hpp"
+#include "std_e/algorithm/parallel_sort.hpp"
 #include "std_e/utils/functional.hpp"
 
 
@@ -125,6 +126,51 @@ unique_compress_copy_with_index_position(std::vector<T,A>& v, F compress_while_e
 }
 
 
+// parallel versions {
+/// `eq` must be an equivalence relation (as for the sequential `unique`, in practice)
+template<class T, class A, class Equiv_pred = std::equal_to<>> auto
+unique(const parallel_policy& pol, std::vector<T,A>& v, Equiv_pred eq = {}) -> void {
+  auto compress_while_eq = [&eq](auto f, auto l){ return std::find_if_not(f,l,[&](const auto& x){ return eq(*f,x); }); };
+  auto new_end = unique_compress(pol,begin(v),end(v),compress_while_eq);
+  v.erase(new_end,end(v));
+}
+
+template<class T, class A, class Equiv_pred = std::equal_to<>, class Comp_pred = std::less<>> auto
+sort_unique(const parallel_policy& pol, std::vector<T,A>& v, Equiv_pred eq = {}, Comp_pred cmp = {}) -> void {
+  parallel_stable_sort(pol,begin(v),end(v),cmp);
+  unique(pol,v,eq);
+}
+
+/// `compress_while_eq` must satisfy the requirements of the parallel `unique_compress` (see unique_compress.hpp)
+template<class T, class A, class F> auto
+unique_compress(const parallel_policy& pol, std::vector<T,A>& v, F compress_while_eq) -> void {
+  auto new_end = unique_compress(pol,begin(v),end(v),compress_while_eq);
+  v.erase(new_end,end(v));
+}
+template<class T, class A, class F> auto
+unique_compress_copy(const parallel_policy& pol, std::vector<T,A>& v, F compress_while_eq) -> std::vector<T> {
+  std::vector<T> res(v.size());
+  auto res_end = unique_compress_copy(pol,begin(v),end(v),begin(res),compress_while_eq);
+  res.erase(res_end,end(res));
+  return res;
+}
+template<class I, class T, class A, class F> auto
+unique_compress_copy_with_index_position(const parallel_policy& pol, std::vector<T,A>& v, F compress_while_eq) -> std::pair<std::vector<T>,std::vector<I>> {
+  std::vector<T> compress_res(v.size());
+  std::vector<I> position_res(v.size());
+  auto res_end = unique_compress_copy_with_index_position(
+    pol,
+    begin(v),end(v),
+    begin(compress_res),
+    I(0),begin(position_res),
+    compress_while_eq
+  );
+  compress_res.erase(res_end,end(compress_res));
+  return std::make_pair(std::move(compress_res),std::move(position_res));
+}
+// parallel versions }
+
+
 template<class T, class A, class I> constexpr auto
 make_sub_vector(const std::vector<T,A>& x, I start, I sub_size) {
   std::vector<T,A> sub(sub_size);